@@ -0,0 +1,35 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec3 Color;
+
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+};
+
+uniform vec4 nearClip;   // xz min/max of the area drawn with full-detail chunks
+uniform vec2 fogRange;   // Horizontal distance where fog starts / is complete
+
+const vec3 skyColor = vec3(0.53, 0.81, 0.92);  // Matches the clear colour
+
+void main() {
+    if (FragPos.x >= nearClip.x && FragPos.x < nearClip.z &&
+        FragPos.z >= nearClip.y && FragPos.z < nearClip.w) {
+        discard;
+    }
+
+    // Same fixed face shading as full-detail chunks, with the far terrain always under open sky
+    vec3 norm = normalize(Normal);
+    float shade = norm.y > 0.5 ? 1.0 : (norm.y < -0.5 ? 0.5 : (abs(norm.z) > 0.5 ? 0.8 : 0.6));
+    vec3 result = shade * lightColor.rgb * Color;
+
+    float distance = length(FragPos.xz - viewPos.xz);
+    float fog = smoothstep(fogRange.x, fogRange.y, distance);
+    FragColor = vec4(mix(result, skyColor, fog), 1.0);
+}
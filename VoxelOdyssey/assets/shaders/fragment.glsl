@@ -1,36 +1,31 @@
 #version 330 core
 out vec4 FragColor;
 
-in vec3 FragPos;
-in vec3 Normal;
 in vec2 TexCoord;
-in float AO;
+in float Brightness;
 
 uniform sampler2D texture1;
-uniform vec3 lightPos;
-uniform vec3 lightColor;
-uniform vec3 viewPos;
 
-void main() {
-    //ambient
-    float ambientStrength = 0.1;
-    vec3 ambient = ambientStrength * lightColor;
+#ifdef FOG
+in float ViewDistance;
+uniform vec2 fogRange;   // Horizontal distance where fog starts / is complete
 
-    //Diffuse
-    vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(lightPos - FragPos);
-    float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor;
+const vec3 skyColor = vec3(0.53, 0.81, 0.92);  // Matches the clear colour
+#endif
 
-    //Specular
-    float specularStrength = 0.5;
-    vec3 viewDir = normalize(viewPos - FragPos);
-    vec3 reflectDir = reflect(-lightDir, norm);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-    vec3 specular = specularStrength * spec * lightColor;
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+};
 
-    // Apply ambient occlusion to lighting
-    vec3 lighting = (ambient + diffuse + specular) * AO;
-    vec3 result = lighting * texture(texture1, TexCoord).rgb;
+void main() {
+    // Voxel light, face shading and AO are all baked per vertex
+    vec3 result = Brightness * lightColor.rgb * texture(texture1, TexCoord).rgb;
+#ifdef FOG
+    result = mix(result, skyColor, smoothstep(fogRange.x, fogRange.y, ViewDistance));
+#endif
     FragColor = vec4(result, 1.0);
-}
\ No newline at end of file
+}
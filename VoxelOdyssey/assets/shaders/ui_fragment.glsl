@@ -0,0 +1,12 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoord;
+in vec4 Color;
+
+// Untextured quads sample a 1x1 white texture so everything shares one program
+uniform sampler2D uiTexture;
+
+void main() {
+    FragColor = texture(uiTexture, TexCoord) * Color;
+}
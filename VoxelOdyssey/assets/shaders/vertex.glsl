@@ -3,20 +3,47 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 layout (location = 3) in float aAO;
+layout (location = 4) in vec2 aLight;
 
-out vec3 FragPos;
-out vec3 Normal;
 out vec2 TexCoord;
-out float AO;
+out float Brightness;
+#ifdef FOG
+out float ViewDistance;
+#endif
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+};
+
+// Chunks are only ever translated, so a world-space offset replaces the model matrix
+uniform vec3 chunkOffset;
+
+// Fixed per-face shading keeps block edges readable without a light direction
+float faceShade(vec3 normal) {
+    if (normal.y > 0.5) return 1.0;
+    if (normal.y < -0.5) return 0.5;
+    return abs(normal.z) > 0.5 ? 0.8 : 0.6;
+}
 
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    // Each light level is 80% as bright as the one above it, so light fades quickly
+    // away from the sky or a light source but caves never go fully black
+    float level = max(aLight.x, aLight.y) * 15.0;
+#ifdef AO
+    float ao = aAO;
+#else
+    float ao = 1.0;
+#endif
+    Brightness = pow(0.8, 15.0 - level) * faceShade(aNormal) * ao;
+
+    vec3 worldPos = aPos + chunkOffset;
+#ifdef FOG
+    ViewDistance = length(worldPos.xz - viewPos.xz);
+#endif
     TexCoord = aTexCoord;
-    AO = aAO;
-    gl_Position = projection * view * vec4(FragPos, 1.0);
-}
\ No newline at end of file
+    gl_Position = projection * view * vec4(worldPos, 1.0);
+}
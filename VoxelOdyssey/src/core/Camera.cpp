@@ -59,6 +59,12 @@ void Camera::processMouseMovement(float xoffset, float yoffset, bool constrainPi
     updateCameraVectors();
 }
 
+void Camera::setOrientation(float yaw, float pitch) {
+    m_yaw = yaw;
+    m_pitch = pitch;
+    updateCameraVectors();
+}
+
 void Camera::processMouseScroll(float yoffset) {
     m_zoom -= (float)yoffset;
     if (m_zoom < 1.0f)
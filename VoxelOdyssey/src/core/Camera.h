@@ -13,6 +13,12 @@ public:
     glm::vec3 getFront() const { return m_front; }
     glm::vec3 getUp() const { return m_up; }
     glm::vec3 getRight() const { return m_right; }
+    float getYaw() const { return m_yaw; }
+    float getPitch() const { return m_pitch; }
+    
+    // Direct placement, used by replay playback
+    void setPosition(const glm::vec3& position) { m_position = position; }
+    void setOrientation(float yaw, float pitch);
     
     void processKeyboard(int direction, float deltaTime);
     void processMouseMovement(float xoffset, float yoffset, bool constrainPitch = true);
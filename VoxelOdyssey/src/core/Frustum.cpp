@@ -90,3 +90,29 @@ bool Frustum::isAABBInside(const glm::vec3& min, const glm::vec3& max) const {
     return true; // AABB intersects or is inside the frustum
 }
 
+FrustumTest Frustum::classifyAABB(const glm::vec3& min, const glm::vec3& max) const {
+    FrustumTest result = FrustumTest::INSIDE;
+    for (int i = 0; i < 6; i++) {
+        // Positive vertex decides outside; the opposite (negative) vertex decides inside
+        glm::vec3 positiveVertex, negativeVertex;
+        positiveVertex.x = (planes[i].x >= 0.0f) ? max.x : min.x;
+        positiveVertex.y = (planes[i].y >= 0.0f) ? max.y : min.y;
+        positiveVertex.z = (planes[i].z >= 0.0f) ? max.z : min.z;
+        negativeVertex.x = (planes[i].x >= 0.0f) ? min.x : max.x;
+        negativeVertex.y = (planes[i].y >= 0.0f) ? min.y : max.y;
+        negativeVertex.z = (planes[i].z >= 0.0f) ? min.z : max.z;
+        
+        float positiveDistance = planes[i].x * positiveVertex.x + planes[i].y * positiveVertex.y +
+                                 planes[i].z * positiveVertex.z + planes[i].w;
+        if (positiveDistance < 0.0f) {
+            return FrustumTest::OUTSIDE;
+        }
+        float negativeDistance = planes[i].x * negativeVertex.x + planes[i].y * negativeVertex.y +
+                                 planes[i].z * negativeVertex.z + planes[i].w;
+        if (negativeDistance < 0.0f) {
+            result = FrustumTest::INTERSECTS;
+        }
+    }
+    return result;
+}
+
@@ -2,6 +2,13 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+// Result of classifying a box against all six planes
+enum class FrustumTest {
+    OUTSIDE,
+    INTERSECTS,
+    INSIDE
+};
+
 // Frustum planes for culling
 struct Frustum {
     glm::vec4 planes[6]; // left, right, bottom, top, near, far
@@ -15,6 +22,9 @@ struct Frustum {
     // Test if an AABB (axis-aligned bounding box) intersects the frustum
     bool isAABBInside(const glm::vec3& min, const glm::vec3& max) const;
     
+    // Like isAABBInside, but also tells boxes entirely inside apart from ones crossing a plane
+    FrustumTest classifyAABB(const glm::vec3& min, const glm::vec3& max) const;
+    
     // Normalize a plane equation
     void normalizePlane(glm::vec4& plane);
 };
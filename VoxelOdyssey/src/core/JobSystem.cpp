@@ -0,0 +1,152 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+struct Job {
+    std::function<void()> work;
+    JobPriority priority = JobPriority::NORMAL;
+    std::atomic<bool> done{false};
+    // Guarded by s_mutex
+    int pendingDependencies = 0;
+    std::vector<JobHandle> dependents;
+};
+
+// One lock for everything: jobs are whole chunks and columns, so it is rarely contended
+static std::mutex s_mutex;
+static std::condition_variable s_workAvailable;
+static std::condition_variable s_jobFinished;
+static std::deque<JobHandle> s_ready[2];    // Indexed by JobPriority
+static std::vector<std::thread> s_workers;
+static bool s_stopping = false;
+
+static bool hasReadyJob() {
+    return !s_ready[0].empty() || !s_ready[1].empty();
+}
+
+// Caller holds s_mutex
+static JobHandle popReadyJob() {
+    for (auto& queue : s_ready) {
+        if (!queue.empty()) {
+            JobHandle job = std::move(queue.front());
+            queue.pop_front();
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+// Caller holds s_mutex
+static void pushReadyJob(const JobHandle& job) {
+    s_ready[static_cast<int>(job->priority)].push_back(job);
+    s_workAvailable.notify_one();
+}
+
+static void runJob(const JobHandle& job) {
+    job->work();
+    job->work = nullptr;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    job->done = true;
+    for (const JobHandle& dependent : job->dependents) {
+        if (--dependent->pendingDependencies == 0) {
+            pushReadyJob(dependent);
+        }
+    }
+    job->dependents.clear();
+    s_jobFinished.notify_all();
+}
+
+static void workerLoop() {
+    while (true) {
+        JobHandle job;
+        {
+            std::unique_lock<std::mutex> lock(s_mutex);
+            s_workAvailable.wait(lock, [] { return s_stopping || hasReadyJob(); });
+            if (!hasReadyJob()) {
+                return;
+            }
+            job = popReadyJob();
+        }
+        runJob(job);
+    }
+}
+
+void JobSystem::init(int threadCount) {
+    if (!s_workers.empty()) return;
+    if (threadCount <= 0) {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+
+    s_stopping = false;
+    for (int i = 0; i < threadCount; i++) {
+        s_workers.emplace_back(workerLoop);
+    }
+}
+
+void JobSystem::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_stopping = true;
+    }
+    s_workAvailable.notify_all();
+    for (std::thread& worker : s_workers) {
+        worker.join();
+    }
+    s_workers.clear();
+}
+
+int JobSystem::getWorkerCount() {
+    return static_cast<int>(s_workers.size());
+}
+
+JobHandle JobSystem::submit(std::function<void()> work, const std::vector<JobHandle>& dependencies,
+                            JobPriority priority) {
+    auto job = std::make_shared<Job>();
+    job->work = std::move(work);
+    job->priority = priority;
+
+    if (s_workers.empty()) {
+        // Inline: every earlier job has already run, unless it was queued before shutdown
+        for (const JobHandle& dependency : dependencies) {
+            if (dependency) wait(dependency);
+        }
+        runJob(job);
+        return job;
+    }
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    for (const JobHandle& dependency : dependencies) {
+        if (dependency && !dependency->done) {
+            dependency->dependents.push_back(job);
+            job->pendingDependencies++;
+        }
+    }
+    if (job->pendingDependencies == 0) {
+        pushReadyJob(job);
+    }
+    return job;
+}
+
+bool JobSystem::isDone(const JobHandle& job) {
+    return !job || job->done;
+}
+
+void JobSystem::wait(const JobHandle& job) {
+    while (!isDone(job)) {
+        JobHandle next;
+        {
+            std::unique_lock<std::mutex> lock(s_mutex);
+            if (job->done) break;
+            next = popReadyJob();
+            if (!next) {
+                s_jobFinished.wait(lock, [&job] { return job->done || hasReadyJob(); });
+                continue;
+            }
+        }
+        runJob(next);
+    }
+}
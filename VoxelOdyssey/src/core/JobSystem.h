@@ -0,0 +1,32 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <vector>
+
+struct Job;
+using JobHandle = std::shared_ptr<Job>;
+
+enum class JobPriority {
+    HIGH,       // Small jobs others are waiting on
+    NORMAL
+};
+
+// Worker thread pool for CPU-only work (nothing that touches GL). A job can depend on
+// other jobs and only becomes runnable once all of them have finished, so multi-stage
+// work is submitted up front as a graph rather than sequenced by the caller.
+// submit, isDone and wait may be called from any thread, including from inside a job.
+class JobSystem {
+public:
+    // threadCount 0 uses one thread less than the hardware has, leaving the main thread
+    // its core. Until init (or after shutdown) jobs run inline on the submitting thread.
+    static void init(int threadCount = 0);
+    // Runs whatever is already queued, then joins the workers
+    static void shutdown();
+    static int getWorkerCount();
+
+    static JobHandle submit(std::function<void()> work, const std::vector<JobHandle>& dependencies = {},
+                            JobPriority priority = JobPriority::NORMAL);
+    static bool isDone(const JobHandle& job);
+    // Blocks until the job has run, running other ready jobs in the meantime
+    static void wait(const JobHandle& job);
+};
@@ -0,0 +1,319 @@
+#include "Profiler.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// CPU scope storage: one fixed-size ring per thread. The owning thread is the only
+// writer, so recording is a couple of stores; old events are simply overwritten.
+// Fields are atomic because export reads them while the owner writes; relaxed stores
+// compile to the same plain moves.
+struct ScopeEvent {
+    std::atomic<const char*> name;
+    std::atomic<uint64_t> startNs;
+    std::atomic<uint64_t> endNs;
+};
+
+// A copy of one event taken by export
+struct ScopeRecord {
+    const char* name;
+    uint64_t startNs;
+    uint64_t endNs;
+};
+
+static constexpr size_t SCOPE_RING_SIZE = 8192;
+
+struct ThreadScopeBuffer {
+    uint32_t threadId = 0;
+    std::array<ScopeEvent, SCOPE_RING_SIZE> events;
+    std::atomic<uint64_t> claimed{0};   // Events started; runs ahead of written while one is stored
+    std::atomic<uint64_t> written{0};   // Events complete
+};
+
+static std::mutex s_bufferMutex;
+static std::vector<std::unique_ptr<ThreadScopeBuffer>> s_threadBuffers;
+static thread_local ThreadScopeBuffer* t_scopeBuffer = nullptr;
+// Workers and asset loaders can register before the main thread, so it is noted in init
+static uint32_t s_mainThreadId = 0;
+
+static std::atomic<int64_t> s_counters[PROFILE_COUNTER_COUNT];
+
+static ThreadScopeBuffer* getThreadBuffer() {
+    if (!t_scopeBuffer) {
+        // Registered once per thread; buffers live until shutdown so export can read them
+        std::lock_guard<std::mutex> lock(s_bufferMutex);
+        s_threadBuffers.push_back(std::make_unique<ThreadScopeBuffer>());
+        t_scopeBuffer = s_threadBuffers.back().get();
+        t_scopeBuffer->threadId = static_cast<uint32_t>(s_threadBuffers.size());
+    }
+    return t_scopeBuffer;
+}
+
+bool Profiler::s_initialized = false;
+bool Profiler::s_overlayVisible = false;
+int Profiler::s_activeTimer = -1;
+uint64_t Profiler::s_frameIndex = 0;
+uint64_t Profiler::s_epochNs = 0;
+FrameProfile Profiler::s_current;
+std::array<FrameProfile, Profiler::HISTORY_SIZE> Profiler::s_history;
+int Profiler::s_historyHead = 0;
+int Profiler::s_historyCount = 0;
+unsigned int Profiler::s_queries[GPU_TIMER_COUNT][GPU_QUERY_LATENCY] = {};
+bool Profiler::s_queryIssued[GPU_TIMER_COUNT][GPU_QUERY_LATENCY] = {};
+uint64_t Profiler::s_queryFrame[GPU_QUERY_LATENCY] = {};
+
+uint64_t Profiler::nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::init() {
+    if (s_initialized) return;
+
+    s_epochNs = nowNs();
+    s_mainThreadId = getThreadBuffer()->threadId;
+    glGenQueries(GPU_TIMER_COUNT * GPU_QUERY_LATENCY, &s_queries[0][0]);
+    s_initialized = true;
+}
+
+void Profiler::cleanup() {
+    if (!s_initialized) return;
+
+    if (s_activeTimer >= 0) {
+        glEndQuery(GL_TIME_ELAPSED);
+        s_activeTimer = -1;
+    }
+    glDeleteQueries(GPU_TIMER_COUNT * GPU_QUERY_LATENCY, &s_queries[0][0]);
+    for (int t = 0; t < GPU_TIMER_COUNT; t++) {
+        for (int slot = 0; slot < GPU_QUERY_LATENCY; slot++) {
+            s_queries[t][slot] = 0;
+            s_queryIssued[t][slot] = false;
+        }
+    }
+    s_initialized = false;
+}
+
+void Profiler::beginFrame() {
+    if (!s_initialized) init();
+
+    // This slot was last used GPU_QUERY_LATENCY frames ago; read it back before reuse
+    int slot = static_cast<int>(s_frameIndex % GPU_QUERY_LATENCY);
+    collectGpuResults(slot);
+    s_queryFrame[slot] = s_frameIndex;
+
+    s_current = FrameProfile();
+    s_current.frameIndex = s_frameIndex;
+    s_current.startNs = nowNs();
+    for (auto& counter : s_counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::endFrame() {
+    if (!s_initialized) return;
+
+    uint64_t endNs = nowNs();
+    recordScope("Frame", s_current.startNs, endNs);
+    s_current.cpuMs = (endNs - s_current.startNs) / 1.0e6f;
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; i++) {
+        s_current.counters[i] = s_counters[i].load(std::memory_order_relaxed);
+    }
+
+    s_history[s_historyHead] = s_current;
+    s_historyHead = (s_historyHead + 1) % HISTORY_SIZE;
+    s_historyCount = std::min(s_historyCount + 1, HISTORY_SIZE);
+    s_frameIndex++;
+}
+
+void Profiler::beginGpu(GpuTimer timer) {
+    // Timer queries of the same target can't nest; skip rather than raise a GL error
+    if (!s_initialized || s_activeTimer >= 0) return;
+
+    int t = static_cast<int>(timer);
+    int slot = static_cast<int>(s_frameIndex % GPU_QUERY_LATENCY);
+    if (s_queryIssued[t][slot]) return;  // Each pass is timed once per frame
+
+    glBeginQuery(GL_TIME_ELAPSED, s_queries[t][slot]);
+    s_queryIssued[t][slot] = true;
+    s_activeTimer = t;
+}
+
+void Profiler::endGpu(GpuTimer timer) {
+    if (s_activeTimer != static_cast<int>(timer)) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    s_activeTimer = -1;
+}
+
+void Profiler::collectGpuResults(int slot) {
+    FrameProfile* frame = findFrame(s_queryFrame[slot]);
+
+    for (int t = 0; t < GPU_TIMER_COUNT; t++) {
+        if (!s_queryIssued[t][slot]) continue;
+        s_queryIssued[t][slot] = false;
+
+        // Never block: a result that isn't ready yet is dropped
+        GLint available = 0;
+        glGetQueryObjectiv(s_queries[t][slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available || !frame) continue;
+
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(s_queries[t][slot], GL_QUERY_RESULT, &elapsedNs);
+        frame->gpuMs[t] = elapsedNs / 1.0e6f;
+    }
+}
+
+FrameProfile* Profiler::findFrame(uint64_t frameIndex) {
+    if (frameIndex >= s_frameIndex) return nullptr;
+
+    uint64_t age = s_frameIndex - frameIndex;  // 1 = last completed frame
+    if (age > static_cast<uint64_t>(s_historyCount)) return nullptr;
+
+    int index = (s_historyHead - static_cast<int>(age) + HISTORY_SIZE) % HISTORY_SIZE;
+    return &s_history[index];
+}
+
+void Profiler::increment(ProfileCounter counter, int64_t amount) {
+    s_counters[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void Profiler::recordScope(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadScopeBuffer* buffer = getThreadBuffer();
+    uint64_t index = buffer->written.load(std::memory_order_relaxed);
+    // Claimed before the slot is overwritten, so an export copying it at the same time
+    // knows its copy may be torn (see exportChromeTrace)
+    buffer->claimed.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    ScopeEvent& event = buffer->events[index % SCOPE_RING_SIZE];
+    event.name.store(name, std::memory_order_relaxed);
+    event.startNs.store(startNs, std::memory_order_relaxed);
+    event.endNs.store(endNs, std::memory_order_relaxed);
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+const FrameProfile& Profiler::getFrame(int index) {
+    int start = (s_historyHead - s_historyCount + HISTORY_SIZE) % HISTORY_SIZE;
+    return s_history[(start + index) % HISTORY_SIZE];
+}
+
+const FrameProfile& Profiler::getLastFrame() {
+    return s_history[(s_historyHead - 1 + HISTORY_SIZE) % HISTORY_SIZE];
+}
+
+const char* Profiler::getCounterName(ProfileCounter counter) {
+    switch (counter) {
+        case ProfileCounter::CHUNKS_GENERATED: return "Chunks Generated";
+        case ProfileCounter::CHUNKS_MESHED: return "Chunks Meshed";
+        case ProfileCounter::CHUNKS_UPLOADED: return "Chunks Uploaded";
+        case ProfileCounter::CHUNKS_DRAWN: return "Chunks Drawn";
+        case ProfileCounter::TRIANGLES: return "Triangles";
+        case ProfileCounter::UPLOAD_BYTES: return "Upload Bytes";
+        case ProfileCounter::UPLOAD_BYTES_DIRECT: return "Upload Bytes (Direct)";
+        default: return "Unknown";
+    }
+}
+
+const char* Profiler::getGpuTimerName(GpuTimer timer) {
+    switch (timer) {
+        case GpuTimer::SKYBOX: return "GPU Skybox";
+        case GpuTimer::WORLD: return "GPU World";
+        case GpuTimer::UI: return "GPU UI";
+        case GpuTimer::MESH_UPLOAD: return "GPU Mesh Upload";
+        default: return "Unknown";
+    }
+}
+
+static void writeJsonString(std::ofstream& file, const char* str) {
+    file << '"';
+    for (const char* c = str; *c; c++) {
+        if (*c == '"' || *c == '\\') file << '\\';
+        file << *c;
+    }
+    file << '"';
+}
+
+bool Profiler::exportChromeTrace(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write profiler trace: " << filename << std::endl;
+        return false;
+    }
+
+    // Timestamps are microseconds since Profiler::init()
+    auto toUs = [](uint64_t ns) { return (ns > s_epochNs ? ns - s_epochNs : 0) / 1000.0; };
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+    size_t eventCount = 0;
+
+    // CPU scopes from every thread that has recorded one
+    {
+        std::lock_guard<std::mutex> lock(s_bufferMutex);
+        std::vector<ScopeRecord> records;
+        for (const auto& buffer : s_threadBuffers) {
+            file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                 << ",\"args\":{\"name\":\"" << (buffer->threadId == s_mainThreadId ? "Main" : "Worker") << "\"}}";
+
+            // Other threads keep recording while we copy. Slot i is reused by event
+            // i + SCOPE_RING_SIZE; if that has been claimed by the time the copy is done,
+            // the copy of event i may be torn and is skipped.
+            uint64_t written = buffer->written.load(std::memory_order_acquire);
+            uint64_t first = written - std::min<uint64_t>(written, SCOPE_RING_SIZE);
+            records.clear();
+            for (uint64_t i = first; i < written; i++) {
+                const ScopeEvent& event = buffer->events[i % SCOPE_RING_SIZE];
+                records.push_back({event.name.load(std::memory_order_relaxed),
+                                   event.startNs.load(std::memory_order_relaxed),
+                                   event.endNs.load(std::memory_order_relaxed)});
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t claimed = buffer->claimed.load(std::memory_order_relaxed);
+            uint64_t firstIntact = claimed > SCOPE_RING_SIZE ? claimed - SCOPE_RING_SIZE : 0;
+
+            for (uint64_t i = std::max(first, firstIntact); i < written; i++) {
+                const ScopeRecord& event = records[i - first];
+                file << ",\n{\"name\":";
+                writeJsonString(file, event.name);
+                file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                     << ",\"ts\":" << toUs(event.startNs)
+                     << ",\"dur\":" << (event.endNs - event.startNs) / 1000.0 << "}";
+                eventCount++;
+            }
+        }
+    }
+
+    // GPU passes and counters per frame. GPU passes are laid out back-to-back from
+    // the frame start: durations are measured, offsets are not.
+    for (int i = 0; i < s_historyCount; i++) {
+        const FrameProfile& frame = getFrame(i);
+        double ts = toUs(frame.startNs);
+
+        for (int t = 0; t < GPU_TIMER_COUNT; t++) {
+            if (frame.gpuMs[t] <= 0.0f) continue;
+            double dur = frame.gpuMs[t] * 1000.0;
+            file << ",\n{\"name\":\"" << getGpuTimerName(static_cast<GpuTimer>(t))
+                 << "\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":" << ts << ",\"dur\":" << dur << "}";
+            ts += dur;
+            eventCount++;
+        }
+
+        for (int c = 0; c < PROFILE_COUNTER_COUNT; c++) {
+            file << ",\n{\"name\":\"" << getCounterName(static_cast<ProfileCounter>(c))
+                 << "\",\"ph\":\"C\",\"pid\":1,\"ts\":" << toUs(frame.startNs)
+                 << ",\"args\":{\"value\":" << frame.counters[c] << "}}";
+            eventCount++;
+        }
+    }
+
+    file << "\n]}\n";
+    std::cout << "Profiler trace written to " << filename << " (" << eventCount << " events)" << std::endl;
+    return true;
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Per-frame counters, reset at the start of every frame
+enum class ProfileCounter {
+    CHUNKS_GENERATED,
+    CHUNKS_MESHED,
+    CHUNKS_UPLOADED,
+    CHUNKS_DRAWN,
+    TRIANGLES,
+    UPLOAD_BYTES,           // Mesh data staged through UploadRing
+    UPLOAD_BYTES_DIRECT,    // Mesh data uploaded directly once the ring budget ran out
+    COUNT
+};
+
+// GPU passes timed with GL_TIME_ELAPSED queries (these must not overlap)
+enum class GpuTimer {
+    SKYBOX,
+    WORLD,
+    UI,
+    MESH_UPLOAD,
+    COUNT
+};
+
+constexpr int PROFILE_COUNTER_COUNT = static_cast<int>(ProfileCounter::COUNT);
+constexpr int GPU_TIMER_COUNT = static_cast<int>(GpuTimer::COUNT);
+
+struct FrameProfile {
+    uint64_t frameIndex = 0;
+    uint64_t startNs = 0;
+    float cpuMs = 0.0f;
+    float gpuMs[GPU_TIMER_COUNT] = {};  // Filled in a few frames late, once the queries resolve
+    int64_t counters[PROFILE_COUNTER_COUNT] = {};
+};
+
+// Lightweight frame profiler. CPU scopes are recorded into a fixed ring buffer
+// per thread (no locking on the hot path), GPU passes use buffered timer queries
+// so reading results never stalls the pipeline.
+class Profiler {
+public:
+    static constexpr int HISTORY_SIZE = 240;
+
+    // Call from the main thread; its scopes are labelled "Main" in exported traces
+    static void init();
+    static void cleanup();
+
+    static void beginFrame();
+    static void endFrame();
+
+    static void beginGpu(GpuTimer timer);
+    static void endGpu(GpuTimer timer);
+
+    static void increment(ProfileCounter counter, int64_t amount = 1);
+
+    // Record a finished CPU scope; name must be a string literal (stored by pointer)
+    static void recordScope(const char* name, uint64_t startNs, uint64_t endNs);
+    static uint64_t nowNs();
+
+    // Write scopes, GPU passes and counters in Chrome's trace event format
+    // (open with chrome://tracing or ui.perfetto.dev)
+    static bool exportChromeTrace(const std::string& filename = "profile_trace.json");
+
+    static bool isOverlayVisible() { return s_overlayVisible; }
+    static void toggleOverlay() { s_overlayVisible = !s_overlayVisible; }
+
+    // Frame history, oldest first (index 0 .. getHistoryCount()-1)
+    static int getHistoryCount() { return s_historyCount; }
+    static const FrameProfile& getFrame(int index);
+    static const FrameProfile& getLastFrame();
+
+    static const char* getCounterName(ProfileCounter counter);
+    static const char* getGpuTimerName(GpuTimer timer);
+
+private:
+    static constexpr int GPU_QUERY_LATENCY = 4;  // Frames in flight before a query is read back
+
+    static bool s_initialized;
+    static bool s_overlayVisible;
+    static int s_activeTimer;
+    static uint64_t s_frameIndex;
+    static uint64_t s_epochNs;
+    static FrameProfile s_current;
+    static std::array<FrameProfile, HISTORY_SIZE> s_history;
+    static int s_historyHead;
+    static int s_historyCount;
+
+    // Query objects indexed [timer][frame slot]
+    static unsigned int s_queries[GPU_TIMER_COUNT][GPU_QUERY_LATENCY];
+    static bool s_queryIssued[GPU_TIMER_COUNT][GPU_QUERY_LATENCY];
+    static uint64_t s_queryFrame[GPU_QUERY_LATENCY];
+
+    static void collectGpuResults(int slot);
+    static FrameProfile* findFrame(uint64_t frameIndex);
+};
+
+// RAII CPU timing scope
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : m_name(name), m_start(Profiler::nowNs()) {}
+    ~ProfileScope() { Profiler::recordScope(m_name, m_start, Profiler::nowNs()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
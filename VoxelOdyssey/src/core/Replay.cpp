@@ -0,0 +1,106 @@
+#include "Replay.h"
+#include "Camera.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+static const char* REPLAY_HEADER = "VOXREPLAY";
+static constexpr int REPLAY_VERSION = 1;
+
+bool ReplayRecorder::start(const std::string& filename) {
+    stop();
+
+    m_file.open(filename);
+    if (!m_file.is_open()) {
+        std::cerr << "Failed to open replay file for writing: " << filename << std::endl;
+        return false;
+    }
+
+    // Enough digits to round-trip floats exactly, so playback matches the recording
+    m_file << std::setprecision(9);
+    m_file << REPLAY_HEADER << " " << REPLAY_VERSION << "\n";
+    m_pendingEdits.clear();
+    m_frameCount = 0;
+    return true;
+}
+
+void ReplayRecorder::stop() {
+    if (!m_file.is_open()) return;
+
+    m_file.close();
+    std::cout << "Replay recorded: " << m_frameCount << " frames" << std::endl;
+}
+
+void ReplayRecorder::recordEdit(const glm::ivec3& position, BlockType type) {
+    if (!isRecording()) return;
+    m_pendingEdits.push_back({position, type});
+}
+
+void ReplayRecorder::recordFrame(float deltaTime, const Camera& camera) {
+    if (!isRecording()) return;
+
+    glm::vec3 pos = camera.getPosition();
+    m_file << "F " << deltaTime << " " << pos.x << " " << pos.y << " " << pos.z << " "
+           << camera.getYaw() << " " << camera.getPitch() << "\n";
+
+    for (const ReplayEdit& edit : m_pendingEdits) {
+        m_file << "E " << edit.position.x << " " << edit.position.y << " " << edit.position.z << " "
+               << static_cast<int>(edit.type) << "\n";
+    }
+    m_pendingEdits.clear();
+    m_frameCount++;
+}
+
+bool ReplayPlayer::load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open replay file: " << filename << std::endl;
+        return false;
+    }
+
+    std::string header;
+    int version = 0;
+    file >> header >> version;
+    if (header != REPLAY_HEADER || version != REPLAY_VERSION) {
+        std::cerr << "Unsupported replay file: " << filename << std::endl;
+        return false;
+    }
+
+    m_frames.clear();
+    m_nextFrame = 0;
+
+    std::string line;
+    int lineNumber = 1;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty()) continue;
+
+        std::istringstream iss(line);
+        char tag = 0;
+        iss >> tag;
+
+        if (tag == 'F') {
+            ReplayFrame frame;
+            iss >> frame.deltaTime >> frame.position.x >> frame.position.y >> frame.position.z
+                >> frame.yaw >> frame.pitch;
+            if (iss.fail()) {
+                std::cerr << "Malformed replay frame at line " << lineNumber << std::endl;
+                return false;
+            }
+            m_frames.push_back(frame);
+        } else if (tag == 'E') {
+            ReplayEdit edit;
+            int type = 0;
+            iss >> edit.position.x >> edit.position.y >> edit.position.z >> type;
+            if (iss.fail() || m_frames.empty() || type < 0 || type >= BLOCK_TYPE_COUNT) {
+                std::cerr << "Malformed replay edit at line " << lineNumber << std::endl;
+                return false;
+            }
+            edit.type = static_cast<BlockType>(type);
+            m_frames.back().edits.push_back(edit);
+        }
+    }
+
+    std::cout << "Replay loaded: " << m_frames.size() << " frames from " << filename << std::endl;
+    return !m_frames.empty();
+}
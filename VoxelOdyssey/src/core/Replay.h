@@ -0,0 +1,61 @@
+#pragma once
+#include "world/Block.h"
+#include <glm/glm.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class Camera;
+
+struct ReplayEdit {
+    glm::ivec3 position;
+    BlockType type;
+};
+
+// One rendered frame: the camera state it was drawn with and the edits made during it
+struct ReplayFrame {
+    float deltaTime = 0.0f;
+    glm::vec3 position = glm::vec3(0.0f);
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    std::vector<ReplayEdit> edits;
+};
+
+// Replay files are plain text so they can be diffed and trimmed by hand:
+//   VOXREPLAY 1
+//   F <deltaTime> <x> <y> <z> <yaw> <pitch>
+//   E <x> <y> <z> <blockType>      (edits belong to the preceding F line)
+class ReplayRecorder {
+public:
+    ~ReplayRecorder() { stop(); }
+
+    bool start(const std::string& filename);
+    void stop();
+    bool isRecording() const { return m_file.is_open(); }
+
+    // Edits are attached to the next recorded frame
+    void recordEdit(const glm::ivec3& position, BlockType type);
+    void recordFrame(float deltaTime, const Camera& camera);
+
+    int getFrameCount() const { return m_frameCount; }
+
+private:
+    std::ofstream m_file;
+    std::vector<ReplayEdit> m_pendingEdits;
+    int m_frameCount = 0;
+};
+
+class ReplayPlayer {
+public:
+    bool load(const std::string& filename);
+
+    bool isFinished() const { return m_nextFrame >= m_frames.size(); }
+    const ReplayFrame& nextFrame() { return m_frames[m_nextFrame++]; }
+
+    size_t getFrameCount() const { return m_frames.size(); }
+    const ReplayFrame& getFrame(size_t index) const { return m_frames[index]; }
+
+private:
+    std::vector<ReplayFrame> m_frames;
+    size_t m_nextFrame = 0;
+};
@@ -1,5 +1,6 @@
 #include "Settings.h"
 #include "Camera.h"
+#include "world/World.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
@@ -30,6 +31,8 @@ void Settings::initializeDefaultKeybinds() {
     m_keybinds[KeybindAction::HOTBAR_7] = GLFW_KEY_7;
     m_keybinds[KeybindAction::HOTBAR_8] = GLFW_KEY_8;
     m_keybinds[KeybindAction::HOTBAR_9] = GLFW_KEY_9;
+    m_keybinds[KeybindAction::TOGGLE_PROFILER] = GLFW_KEY_F3;
+    m_keybinds[KeybindAction::EXPORT_PROFILE] = GLFW_KEY_F4;
 }
 
 int Settings::getKeybind(KeybindAction action) const {
@@ -56,6 +59,9 @@ std::string Settings::getKeyName(int key) const {
     if (key >= GLFW_KEY_0 && key <= GLFW_KEY_9) {
         return std::string(1, '0' + (key - GLFW_KEY_0));
     }
+    if (key >= GLFW_KEY_F1 && key <= GLFW_KEY_F12) {
+        return "F" + std::to_string(key - GLFW_KEY_F1 + 1);
+    }
     
     switch (key) {
         case GLFW_KEY_SPACE: return "Space";
@@ -103,6 +109,8 @@ std::string Settings::keybindActionToString(KeybindAction action) const {
         case KeybindAction::HOTBAR_7: return "Hotbar Slot 7";
         case KeybindAction::HOTBAR_8: return "Hotbar Slot 8";
         case KeybindAction::HOTBAR_9: return "Hotbar Slot 9";
+        case KeybindAction::TOGGLE_PROFILER: return "Toggle Profiler";
+        case KeybindAction::EXPORT_PROFILE: return "Export Profile";
         default: return "Unknown";
     }
 }
@@ -126,6 +134,8 @@ KeybindAction Settings::stringToKeybindAction(const std::string& str) const {
     if (str == "Hotbar Slot 7") return KeybindAction::HOTBAR_7;
     if (str == "Hotbar Slot 8") return KeybindAction::HOTBAR_8;
     if (str == "Hotbar Slot 9") return KeybindAction::HOTBAR_9;
+    if (str == "Toggle Profiler") return KeybindAction::TOGGLE_PROFILER;
+    if (str == "Export Profile") return KeybindAction::EXPORT_PROFILE;
     return KeybindAction::COUNT;
 }
 
@@ -160,7 +170,12 @@ bool Settings::loadFromFile(const std::string& filename) {
             }
             // Parse visual settings
             else if (key == "renderDistance") {
-                m_visualSettings.renderDistance = std::stoi(value);
+                m_visualSettings.renderDistance = std::clamp(std::stoi(value),
+                                                             VisualSettings::MIN_RENDER_DISTANCE,
+                                                             VisualSettings::MAX_RENDER_DISTANCE);
+            }
+            else if (key == "farTerrainDistance") {
+                m_visualSettings.farTerrainDistance = std::stoi(value);
             }
             else if (key == "fov") {
                 m_visualSettings.fov = std::stof(value);
@@ -198,6 +213,7 @@ bool Settings::saveToFile(const std::string& filename) const {
     
     file << "\n# Visual Settings\n";
     file << "renderDistance=" << m_visualSettings.renderDistance << "\n";
+    file << "farTerrainDistance=" << m_visualSettings.farTerrainDistance << "\n";
     file << "fov=" << m_visualSettings.fov << "\n";
     file << "mouseSensitivity=" << m_visualSettings.mouseSensitivity << "\n";
     file << "movementSpeed=" << m_visualSettings.movementSpeed << "\n";
@@ -212,8 +228,6 @@ void Settings::applySettings(Camera& camera, class World& world) const {
     camera.setMovementSpeed(m_visualSettings.movementSpeed);
     camera.setMouseSensitivity(m_visualSettings.mouseSensitivity);
     camera.setZoom(m_visualSettings.fov);
-    // Note: Render distance would need to be set in World class
-    // This is a placeholder - World would need a setRenderDistance method
-    // For now, render distance is handled in World's constructor/update
+    world.setRenderDistance(m_visualSettings.renderDistance);
 }
 
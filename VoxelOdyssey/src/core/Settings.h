@@ -2,6 +2,7 @@
 #include <string>
 #include <map>
 #include <GLFW/glfw3.h>
+#include "world/World.h"
 
 // Keybind action types
 enum class KeybindAction {
@@ -23,12 +24,19 @@ enum class KeybindAction {
     HOTBAR_7,
     HOTBAR_8,
     HOTBAR_9,
+    TOGGLE_PROFILER,
+    EXPORT_PROFILE,
     COUNT
 };
 
 // Visual quality settings
 struct VisualSettings {
+    // Whatever World accepts, so the menu can reach every distance it can load
+    static constexpr int MIN_RENDER_DISTANCE = World::MIN_RENDER_DISTANCE;
+    static constexpr int MAX_RENDER_DISTANCE = World::MAX_RENDER_DISTANCE;
+    
     int renderDistance = 4;        // Chunk render distance
+    int farTerrainDistance = 32;   // Heightmap LOD view distance in chunks (0 = off)
     bool enableFrustumCulling = true;
     bool enableAmbientOcclusion = true;
     float fov = 45.0f;             // Field of view
@@ -0,0 +1,98 @@
+#include "TimeDemo.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+struct SampleSummary {
+    float min = 0.0f;
+    float avg = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+};
+
+static SampleSummary summarize(std::vector<float> samples) {
+    SampleSummary summary;
+    if (samples.empty()) return summary;
+
+    std::sort(samples.begin(), samples.end());
+    size_t p99Index = static_cast<size_t>(std::ceil(samples.size() * 0.99)) - 1;
+
+    summary.min = samples.front();
+    summary.max = samples.back();
+    summary.p99 = samples[std::min(p99Index, samples.size() - 1)];
+    summary.avg = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    return summary;
+}
+
+void TimeDemo::addChunkLoads(const std::vector<float>& loadMs) {
+    m_chunkLoadTimes.insert(m_chunkLoadTimes.end(), loadMs.begin(), loadMs.end());
+}
+
+void TimeDemo::sampleMemory() {
+    m_lastResidentBytes = getResidentMemoryBytes();
+    m_peakResidentBytes = std::max(m_peakResidentBytes, m_lastResidentBytes);
+}
+
+size_t TimeDemo::getResidentMemoryBytes() {
+#ifdef __linux__
+    // Second field of statm is the resident page count
+    std::ifstream statm("/proc/self/statm");
+    size_t totalPages = 0, residentPages = 0;
+    if (statm >> totalPages >> residentPages) {
+        return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+void TimeDemo::printReport(std::ostream& out) const {
+    SampleSummary frames = summarize(m_frameTimes);
+    SampleSummary loads = summarize(m_chunkLoadTimes);
+    double totalMs = std::accumulate(m_frameTimes.begin(), m_frameTimes.end(), 0.0);
+    double avgFps = totalMs > 0.0 ? m_frameTimes.size() * 1000.0 / totalMs : 0.0;
+    double toMiB = 1.0 / (1024.0 * 1024.0);
+
+    out << std::fixed << std::setprecision(2);
+    out << "=== Timedemo ===" << "\n";
+    out << "Settings:    render distance " << m_visual.renderDistance << ", far terrain "
+        << m_visual.farTerrainDistance << ", AO " << (m_visual.enableAmbientOcclusion ? "on" : "off")
+        << ", frustum culling " << (m_visual.enableFrustumCulling ? "on" : "off")
+        << ", fov " << m_visual.fov << "\n";
+    out << "Frames:      " << m_frameTimes.size() << " in " << totalMs / 1000.0 << "s (" << avgFps << " fps)\n";
+    out << "Frame time:  min " << frames.min << "ms, avg " << frames.avg << "ms, p99 "
+        << frames.p99 << "ms, max " << frames.max << "ms\n";
+    out << "Chunk loads: " << m_chunkLoadTimes.size() << ", avg " << loads.avg << "ms, p99 "
+        << loads.p99 << "ms, max " << loads.max << "ms\n";
+    out << "Memory:      " << m_lastResidentBytes * toMiB << " MiB resident, peak "
+        << m_peakResidentBytes * toMiB << " MiB\n";
+    out << "Raycasts:    " << m_raysPerSecond / 1.0e6 << " M rays/s\n";
+    out << "Chunk pool:  " << m_chunkPool.liveChunks << " live (peak " << m_chunkPool.peakLiveChunks << "), "
+        << m_chunkPool.freeChunks << " free, " << m_chunkPool.bytes * toMiB << " MiB, "
+        << m_chunkPool.heapAllocations << " heap allocations, " << m_chunkPool.reuses << " reused\n";
+
+    out << "TIMEDEMO render_distance=" << m_visual.renderDistance
+        << " far_terrain_distance=" << m_visual.farTerrainDistance
+        << " ao=" << m_visual.enableAmbientOcclusion
+        << " frustum_culling=" << m_visual.enableFrustumCulling
+        << " fov=" << m_visual.fov
+        << " frames=" << m_frameTimes.size()
+        << " frame_min_ms=" << frames.min
+        << " frame_avg_ms=" << frames.avg
+        << " frame_p99_ms=" << frames.p99
+        << " frame_max_ms=" << frames.max
+        << " chunk_loads=" << m_chunkLoadTimes.size()
+        << " chunk_load_avg_ms=" << loads.avg
+        << " chunk_load_p99_ms=" << loads.p99
+        << " rss_mib=" << m_lastResidentBytes * toMiB
+        << " rss_peak_mib=" << m_peakResidentBytes * toMiB
+        << " rays_per_sec=" << m_raysPerSecond
+        << " chunk_pool_peak=" << m_chunkPool.peakLiveChunks
+        << " chunk_heap_allocs=" << m_chunkPool.heapAllocations
+        << " chunk_reuses=" << m_chunkPool.reuses << std::endl;
+}
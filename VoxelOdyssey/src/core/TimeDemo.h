@@ -0,0 +1,39 @@
+#pragma once
+#include "core/Settings.h"
+#include "world/ChunkPool.h"
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// Collects frame times, chunk load latencies and memory use during a
+// replay run and summarises them for regression tracking
+class TimeDemo {
+public:
+    // Rays cast from the final camera position to measure raycast throughput
+    static constexpr int RAYCAST_BENCHMARK_RAYS = 100000;
+
+    void addFrame(float frameMs) { m_frameTimes.push_back(frameMs); }
+    void addChunkLoads(const std::vector<float>& loadMs);
+    void sampleMemory();
+    void setRaycastRate(double raysPerSecond) { m_raysPerSecond = raysPerSecond; }
+    void setChunkPoolStats(const ChunkPoolStats& stats) { m_chunkPool = stats; }
+    // The settings the run used, reported so results are only compared like for like
+    void setVisualSettings(const VisualSettings& visual) { m_visual = visual; }
+
+    size_t getFrameCount() const { return m_frameTimes.size(); }
+
+    // Human-readable summary followed by a single "TIMEDEMO key=value ..." line for scripts
+    void printReport(std::ostream& out) const;
+
+    // Resident set size of this process in bytes (0 where unsupported)
+    static size_t getResidentMemoryBytes();
+
+private:
+    std::vector<float> m_frameTimes;
+    std::vector<float> m_chunkLoadTimes;
+    size_t m_peakResidentBytes = 0;
+    size_t m_lastResidentBytes = 0;
+    double m_raysPerSecond = 0.0;
+    ChunkPoolStats m_chunkPool;
+    VisualSettings m_visual;
+};
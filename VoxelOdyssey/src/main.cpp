@@ -3,11 +3,21 @@
 #include "core/Input.h"
 #include "core/Frustum.h"
 #include "core/Settings.h"
+#include "core/Profiler.h"
+#include "core/Replay.h"
+#include "core/TimeDemo.h"
+#include "core/JobSystem.h"
 #include "renderer/Shader.h"
+#include "renderer/AssetLoader.h"
+#include "renderer/Mesh.h"
+#include "renderer/UploadRing.h"
 #include "renderer/DebugRenderer.h"
 #include "renderer/SimpleHUD.h"
+#include "renderer/UIBatch.h"
 #include "renderer/Skybox.h"
+#include "renderer/FrameUniforms.h"
 #include "world/World.h"
+#include "world/FarTerrain.h"
 #include "world/Raycast.h"
 #include "world/Block.h"
 #include "world/Inventory.h"
@@ -19,9 +29,10 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <string>
 
 // Movement direction constants
 const int FORWARD = 0;
@@ -31,48 +42,151 @@ const int RIGHT = 3;
 const int UP = 4;
 const int DOWN = 5;
 
-int main() {
+// Command line options for recording and benchmarking runs
+struct LaunchOptions {
+    std::string recordFile;    // --record <file>: log camera and block edits every frame
+    std::string timedemoFile;  // --timedemo <file>: replay a recording as fast as possible and report timings
+    float fixedStep = 0.0f;    // --fixed-step <hz>: constant simulation delta instead of wall/recorded time
+};
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--record <file>] [--timedemo <file>] [--fixed-step <hz>]" << std::endl;
+}
+
+// The whole of text as a number; anything else leaves value untouched
+static bool parseFloat(const char* text, float& value) {
+    char* end = nullptr;
+    float parsed = std::strtof(text, &end);
+    if (end == text || *end != '\0') {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+static bool parseCommandLine(int argc, char** argv, LaunchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        
+        if (arg == "--record" && hasValue) {
+            options.recordFile = argv[++i];
+        } else if (arg == "--timedemo" && hasValue) {
+            options.timedemoFile = argv[++i];
+        } else if (arg == "--fixed-step" && hasValue) {
+            float hz = 0.0f;
+            if (!parseFloat(argv[++i], hz)) {
+                printUsage(argv[0]);
+                return false;
+            }
+            options.fixedStep = hz > 0.0f ? 1.0f / hz : 0.0f;
+        } else {
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Features compiled into the world shader; each set of defines is its own program
+static ShaderDefines getWorldShaderDefines(const VisualSettings& visual) {
+    ShaderDefines defines;
+    if (visual.enableAmbientOcclusion) defines.push_back("AO");
+    // Far terrain fogs the horizon itself; without it the chunks fade out instead
+    if (visual.farTerrainDistance == 0) defines.push_back("FOG");
+    return defines;
+}
+
+// Upload steps between AssetLoader::beginStartup and endStartup, for the progress bar
+static constexpr int STARTUP_STEPS = 8;
+
+static unsigned int createAtlasTexture(const ImageData& image) {
+    unsigned int texture = 0;
+    if (!image.isValid()) {
+        return texture;
+    }
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    GLenum format = image.channels == 4 ? GL_RGBA : GL_RGB;
+    glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, image.pixels.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+    return texture;
+}
+
+int main(int argc, char** argv) {
+    LaunchOptions options;
+    if (!parseCommandLine(argc, argv, options)) {
+        return 1;
+    }
+    
+    uint64_t startupStartNs = Profiler::nowNs();
+    
     // Window setup
     Window window(1280, 720, "Voxel Odyssey");
     
     // Initialize input system
     Input::initialize(window.getHandle());
+    
+    // Worker threads for chunk generation
+    JobSystem::init();
 
-    // Texture load (once)
-    unsigned int texture = 0;
-    int width, height, channels;
-    stbi_set_flip_vertically_on_load(true);  // GL convention
-    unsigned char* data = stbi_load("assets/textures/block_atlas.png", &width, &height, &channels, 0);
-    if (data) {
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        GLenum format = channels == 4 ? GL_RGBA : GL_RGB;
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        stbi_image_free(data);
+    // Settings system (loaded first, they pick the world shader's permutation)
+    Settings settings;
+    settings.loadFromFile(); // Load saved settings
+    if (!options.timedemoFile.empty()) {
+        // Benchmarks always run the default view, whatever this machine has saved
+        settings.setVisualSettings(VisualSettings());
     }
-
-    World world;
-    Shader shader("assets/shaders/vertex.glsl", "assets/shaders/fragment.glsl");
-    Shader debugShader("assets/shaders/debug.glsl", "assets/shaders/debug_fragment.glsl");
-    Shader skyboxShader("assets/shaders/skybox_vertex.glsl", "assets/shaders/skybox_fragment.glsl");
+    ShaderDefines worldShaderDefines = getWorldShaderDefines(settings.getVisualSettings());
+    
+    // Start every disk read and CPU-side asset job at once; the GL uploads below
+    // collect them in order while the workers keep going
+    auto atlasImage = AssetLoader::loadImage("assets/textures/block_atlas.png");
+    auto skyboxImage = AssetLoader::run(Skybox::generateProceduralSkybox);
+    auto worldSources = AssetLoader::loadShaderSources("assets/shaders/vertex.glsl", "assets/shaders/fragment.glsl");
+    auto debugSources = AssetLoader::loadShaderSources("assets/shaders/debug.glsl", "assets/shaders/debug_fragment.glsl");
+    auto skyboxSources = AssetLoader::loadShaderSources("assets/shaders/skybox_vertex.glsl", "assets/shaders/skybox_fragment.glsl");
+    auto farTerrainSources = AssetLoader::loadShaderSources("assets/shaders/far_terrain.glsl", "assets/shaders/far_terrain_fragment.glsl");
+    
+    // UI batch first: it draws the progress screen for the remaining steps
+    AssetLoader::beginStartup(window, STARTUP_STEPS, startupStartNs);
+    Profiler::init();
+    UIBatch::init();
+    AssetLoader::completeStep("UI batch");
+    
+    unsigned int texture = createAtlasTexture(AssetLoader::wait(atlasImage));
+    AssetLoader::completeStep("Block atlas");
+    
+    auto shader = std::make_unique<Shader>(AssetLoader::wait(worldSources), worldShaderDefines);
+    // Resolved again whenever the world shader is rebuilt
+    Uniform<glm::vec2> fogRangeUniform = shader->getUniform<glm::vec2>("fogRange");
+    AssetLoader::completeStep("World shader");
+    Shader debugShader(AssetLoader::wait(debugSources));
+    AssetLoader::completeStep("Debug shader");
+    Shader skyboxShader(AssetLoader::wait(skyboxSources));
+    AssetLoader::completeStep("Skybox shader");
+    Shader farTerrainShader(AssetLoader::wait(farTerrainSources));
+    AssetLoader::completeStep("Far terrain shader");
     
-    // Initialize debug renderer, HUD, skybox, and inventory UI
-    DebugRenderer::init();
-    SimpleHUD::init();
-    InventoryUI::init();
-    PauseMenu::init();
-    MainMenu::init();
     Skybox skybox;
-    skybox.init();
+    skybox.init(AssetLoader::wait(skyboxImage));
+    AssetLoader::completeStep("Skybox");
     
-    // Settings system
-    Settings settings;
-    settings.loadFromFile(); // Load saved settings
+    // Per-frame uniforms, streaming buffers and the debug renderer
+    FrameUniforms::init();
+    UploadRing::init();
+    DebugRenderer::init();
+    AssetLoader::completeStep("Render buffers");
+    AssetLoader::endStartup();
+    
+    // Heightmap LOD beyond the chunk render distance
+    FarTerrain farTerrain;
+    farTerrain.setViewDistance(settings.getVisualSettings().farTerrainDistance);
+    farTerrain.resolveUniforms(farTerrainShader);
     
     // World manager
     WorldManager& worldManager = WorldManager::getInstance();
@@ -90,10 +204,46 @@ int main() {
     // Set clear color
     glClearColor(0.53f, 0.81f, 0.92f, 1.0f);  // Sky blue
     
-    // Projection matrix
+    // Replay recording / timedemo playback
+    ReplayRecorder recorder;
+    ReplayPlayer replay;
+    TimeDemo timedemo;
+    timedemo.setVisualSettings(settings.getVisualSettings());
+    bool timedemoMode = false;
+    
+    if (!options.recordFile.empty()) {
+        recorder.start(options.recordFile);
+    }
+    
+    if (!options.timedemoFile.empty()) {
+        if (!replay.load(options.timedemoFile)) {
+            return 1;
+        }
+        timedemoMode = true;
+        glfwSwapInterval(0);  // Run uncapped
+        
+        // Terrain is a pure function of position, so a world that never touches
+        // disk is identical on every run
+        const ReplayFrame& first = replay.getFrame(0);
+        world = new World();
+        world->setWorldName("timedemo");
+        world->setPersistenceEnabled(false);
+        world->setChunkLoadTracking(true);
+        
+        inventory = new Inventory();
+        playerStats = new PlayerStats();
+        camera = new Camera(first.position);
+        camera->setOrientation(first.yaw, first.pitch);
+        settings.applySettings(*camera, *world);
+        
+        gameStarted = true;
+        MainMenu::setOpen(false);
+        Input::setMouseLocked(true);
+    }
+    
+    // Projection matrix (recomputed each frame from the camera zoom)
     glm::vec2 windowSize = window.getSize();
-    glm::mat4 proj = glm::perspective(glm::radians(camera.getZoom()), 
-                                     windowSize.x / windowSize.y, 0.1f, 1000.0f);
+    glm::mat4 proj = glm::mat4(1.0f);
 
     // Timing
     float lastFrame = 0.0f;
@@ -104,10 +254,38 @@ int main() {
         float currentFrame = (float)glfwGetTime();
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
+        Profiler::beginFrame();
+        UploadRing::beginFrame();
+        
+        // Timedemo: drive the camera and edits from the recording instead of input
+        if (timedemoMode) {
+            if (replay.isFinished()) {
+                break;
+            }
+            
+            const ReplayFrame& frame = replay.nextFrame();
+            deltaTime = frame.deltaTime;
+            camera->setPosition(frame.position);
+            camera->setOrientation(frame.yaw, frame.pitch);
+            for (const ReplayEdit& edit : frame.edits) {
+                world->setBlock(edit.position.x, edit.position.y, edit.position.z, edit.type);
+            }
+        }
+        if (options.fixedStep > 0.0f) {
+            deltaTime = options.fixedStep;
+        }
         
         // Update main menu
         MainMenu::update(deltaTime);
         
+        // Profiler overlay / trace export work everywhere, including the main menu
+        if (Input::isKeyJustPressed(settings.getKeybind(KeybindAction::TOGGLE_PROFILER))) {
+            Profiler::toggleOverlay();
+        }
+        if (Input::isKeyJustPressed(settings.getKeybind(KeybindAction::EXPORT_PROFILE))) {
+            Profiler::exportChromeTrace();
+        }
+        
         // Handle main menu navigation
         if (MainMenu::isOpen()) {
             // Check for menu actions
@@ -134,19 +312,21 @@ int main() {
                 }
             }
             else if (MainMenu::getState() == MainMenuState::SELECT_WORLD) {
-                auto worlds = worldManager.getAvailableWorlds();
-                if (!worlds.empty() && Input::isKeyJustPressed(GLFW_KEY_ENTER)) {
+                if (Input::isKeyJustPressed(GLFW_KEY_ENTER)) {
                     int selected = MainMenu::getSelectedWorldIndex();
-                    if (selected >= 0 && selected < (int)worlds.size()) {
+                    if (selected >= 0 && selected < (int)worldManager.getWorldCount()) {
+                        // Copy: setCurrentWorld rewrites world.info, which refreshes the catalogue
+                        WorldInfo selectedWorld = worldManager.getWorld(selected);
+                        
                         // Load selected world
-                        worldManager.setCurrentWorld(worlds[selected].folderName);
+                        worldManager.setCurrentWorld(selectedWorld.folderName);
                         
                         world = new World();
-                        world->setWorldName(worlds[selected].folderName);
+                        world->setWorldName(selectedWorld.folderName);
                         
                         inventory = new Inventory();
                         playerStats = new PlayerStats();
-                        camera = new Camera(worlds[selected].spawnPosition);
+                        camera = new Camera(selectedWorld.spawnPosition);
                         settings.applySettings(*camera, *world);
                         
                         gameStarted = true;
@@ -170,8 +350,17 @@ int main() {
         }
         
         // Update pause menu (only if game is started)
-        if (gameStarted) {
+        if (gameStarted && !timedemoMode) {
             PauseMenu::update(settings, deltaTime);
+            // No-op unless the pause menu changed it
+            world->setRenderDistance(settings.getVisualSettings().renderDistance);
+            
+            ShaderDefines defines = getWorldShaderDefines(settings.getVisualSettings());
+            if (defines != worldShaderDefines) {
+                worldShaderDefines = defines;
+                shader = std::make_unique<Shader>("assets/shaders/vertex.glsl", "assets/shaders/fragment.glsl", worldShaderDefines);
+                fogRangeUniform = shader->getUniform<glm::vec2>("fogRange");
+            }
             
             // Toggle pause menu
             if (Input::isKeyJustPressed(settings.getKeybind(KeybindAction::TOGGLE_PAUSE))) {
@@ -190,8 +379,13 @@ int main() {
             }
         }
         
+        // Block the camera looks at; cast once per frame and shared by interaction and the outline
+        RaycastResult targetHit = {};
+        bool targetValid = false;
+        
         // Only process game input if game is started and not paused
-        if (gameStarted && !PauseMenu::isOpen() && world && camera && inventory) {
+        if (gameStarted && !timedemoMode && !PauseMenu::isOpen() && world && camera && inventory) {
+            PROFILE_SCOPE("Game Input");
             // Process input using settings keybinds
             // Movement
             if (Input::isKeyPressed(settings.getKeybind(KeybindAction::MOVE_FORWARD)))
@@ -238,22 +432,20 @@ int main() {
             }
             
             // Block interaction (only when mouse is locked)
-            RaycastResult hit;
             if (Input::isMouseLocked()) {
                 // Cast ray from camera
                 glm::vec3 camPos = camera->getPosition();
                 glm::vec3 camFront = camera->getFront();
-                
-                auto blockQuery = [world](int x, int y, int z) {
-                    return world->getBlock(x, y, z);
-                };
-                
-                hit = Raycast::cast(camPos, camFront, 10.0f, blockQuery);
+                targetHit = Raycast::cast(camPos, camFront, 10.0f, *world);
+                targetValid = true;
+                const RaycastResult& hit = targetHit;
                 
                 // Left click to destroy block
                 if (Input::isMouseButtonJustPressed(GLFW_MOUSE_BUTTON_LEFT) && hit.hit) {
                     BlockType destroyedBlock = world->getBlock(hit.blockPos.x, hit.blockPos.y, hit.blockPos.z);
                     world->setBlock(hit.blockPos.x, hit.blockPos.y, hit.blockPos.z, BlockType::AIR);
+                    recorder.recordEdit(hit.blockPos, BlockType::AIR);
+                    targetValid = false;  // The outline needs a fresh ray after an edit
                     
                     // Add destroyed block to inventory
                     if (destroyedBlock != BlockType::AIR) {
@@ -270,13 +462,20 @@ int main() {
                         // Only place if the target position is air
                         if (world->getBlock(placePos.x, placePos.y, placePos.z) == BlockType::AIR) {
                             world->setBlock(placePos.x, placePos.y, placePos.z, selectedBlock);
+                            recorder.recordEdit(placePos, selectedBlock);
                             inventory->removeBlock(selectedBlock, 1);
+                            targetValid = false;
                         }
                     }
                 }
             }
         }
         
+        // Log the camera this frame is rendered with (plus any edits made above)
+        if (gameStarted && camera && recorder.isRecording()) {
+            recorder.recordFrame(deltaTime, *camera);
+        }
+        
         // Update input system
         Input::update();
         
@@ -291,80 +490,132 @@ int main() {
         // Render main menu if open
         if (MainMenu::isOpen()) {
             glm::vec2 windowSize = window.getSize();
-            MainMenu::render(debugShader, (int)windowSize.x, (int)windowSize.y);
+            Profiler::beginGpu(GpuTimer::UI);
+            UIBatch::begin((int)windowSize.x, (int)windowSize.y);
+            MainMenu::render((int)windowSize.x, (int)windowSize.y);
+            if (Profiler::isOverlayVisible()) {
+                SimpleHUD::renderProfilerOverlay();
+            }
+            UIBatch::end();
+            Profiler::endGpu(GpuTimer::UI);
         }
         // Render game if started
         else if (gameStarted && world && camera && playerStats && inventory) {
             // Update world
             glm::vec3 camPos = camera->getPosition();
+            Profiler::beginGpu(GpuTimer::MESH_UPLOAD);
             world->update(camPos);
+            farTerrain.update(camPos, world->getRenderDistance());
+            Profiler::endGpu(GpuTimer::MESH_UPLOAD);
             
-            // Render skybox first (before everything else)
-            glm::mat4 view = camera->getViewMatrix();
-            skybox.render(skyboxShader, view, proj);
-
             // Update projection if window size changed
+            glm::mat4 view = camera->getViewMatrix();
             windowSize = window.getSize();
             proj = glm::perspective(glm::radians(camera->getZoom()), 
                                    windowSize.x / windowSize.y, 0.1f, 1000.0f);
 
-            // Calculate frustum for culling
-            glm::mat4 mvp = proj * view;
-            Frustum frustum;
-            frustum.extractFromMatrix(mvp);
+            // Upload per-frame constants shared by the world, skybox and debug shaders
+            FrameUniforms::update(view, proj, camPos,
+                                  camPos + glm::vec3(10,10,10),  // Sun-ish
+                                  glm::vec3(1.0f, 1.0f, 1.0f));
 
-            // Render world
-            shader.use();
-            shader.setMat4("view", view);
-            shader.setMat4("projection", proj);
-            shader.setVec3("viewPos", camPos);
-            shader.setVec3("lightPos", camPos + glm::vec3(10,10,10));  // Sun-ish
-            shader.setVec3("lightColor", glm::vec3(1.0f, 1.0f, 1.0f));
+            {
+                PROFILE_SCOPE("Render");
 
-            world->render(shader, texture, frustum);
+                // Render skybox first (before everything else)
+                Profiler::beginGpu(GpuTimer::SKYBOX);
+                skybox.render(skyboxShader);
+                Profiler::endGpu(GpuTimer::SKYBOX);
+
+                // Calculate frustum for culling
+                glm::mat4 mvp = proj * view;
+                Frustum frustum;
+                frustum.extractFromMatrix(mvp);
+
+                // Render world
+                Profiler::beginGpu(GpuTimer::WORLD);
+                float fogEnd = (float)(world->getRenderDistance() * CHUNK_SIZE);
+                shader->use();
+                shader->set(fogRangeUniform, glm::vec2(fogEnd * 0.6f, fogEnd));
+                world->render(*shader, texture, frustum);
+                farTerrain.render(farTerrainShader, frustum);
+                Profiler::endGpu(GpuTimer::WORLD);
             
-            // Render debug outline for selected block (need to get hit from earlier)
-            static RaycastResult lastHit;
-            if (Input::isMouseLocked() && !PauseMenu::isOpen()) {
-                glm::vec3 camPos2 = camera->getPosition();
-                glm::vec3 camFront = camera->getFront();
-                auto blockQuery = [world](int x, int y, int z) { return world->getBlock(x, y, z); };
-                lastHit = Raycast::cast(camPos2, camFront, 10.0f, blockQuery);
-                
-                if (lastHit.hit) {
-                    DebugRenderer::renderBlockOutline(debugShader, lastHit.blockPos, 
-                                                     camera->getViewMatrix(), proj);
+                // Render debug outline for the targeted block (this frame's ray unless an edit invalidated it)
+                if (Input::isMouseLocked() && !PauseMenu::isOpen()) {
+                    if (!targetValid) {
+                        targetHit = Raycast::cast(camera->getPosition(), camera->getFront(), 10.0f, *world);
+                    }
+                    if (targetHit.hit) {
+                        DebugRenderer::renderBlockOutline(debugShader, targetHit.blockPos);
+                    }
                 }
             }
-            
-            // Render HUD (crosshair, hotbar, and stats)
-            if (Input::isMouseLocked() && !inventoryOpen && !PauseMenu::isOpen()) {
+
+            {
+                // All 2D overlays go through one UI pass so they batch into a single draw
+                PROFILE_SCOPE("UI");
+                Profiler::beginGpu(GpuTimer::UI);
                 glm::vec2 windowSize2 = window.getSize();
-                SimpleHUD::renderCrosshair(debugShader, (int)windowSize2.x, (int)windowSize2.y);
+                UIBatch::begin((int)windowSize2.x, (int)windowSize2.y);
+
+                // Render HUD (crosshair, hotbar, and stats)
+                if (Input::isMouseLocked() && !inventoryOpen && !PauseMenu::isOpen()) {
+                    SimpleHUD::renderCrosshair((int)windowSize2.x, (int)windowSize2.y);
                 
-                // Render health and hunger bars
-                SimpleHUD::renderHealthBar(debugShader, playerStats->getHealth(), (int)windowSize2.x, (int)windowSize2.y);
-                SimpleHUD::renderHungerBar(debugShader, playerStats->getHunger(), (int)windowSize2.x, (int)windowSize2.y);
+                    // Render health and hunger bars
+                    SimpleHUD::renderHealthBar(playerStats->getHealth(), (int)windowSize2.y);
+                    SimpleHUD::renderHungerBar(playerStats->getHunger(), (int)windowSize2.y);
                 
-                // Render hotbar
-                InventoryUI::renderHotbar(debugShader, *inventory, (int)windowSize2.x, (int)windowSize2.y);
-            }
+                    // Render hotbar
+                    InventoryUI::renderHotbar(*inventory, (int)windowSize2.x, (int)windowSize2.y);
+                }
             
-            // Render full inventory if open
-            if (inventoryOpen) {
-                glm::vec2 windowSize2 = window.getSize();
-                InventoryUI::renderInventory(debugShader, *inventory, (int)windowSize2.x, (int)windowSize2.y, true);
-            }
+                // Render full inventory if open
+                if (inventoryOpen) {
+                    InventoryUI::renderInventory(*inventory, (int)windowSize2.x, (int)windowSize2.y, true);
+                }
             
-            // Render pause menu
-            if (PauseMenu::isOpen()) {
-                glm::vec2 windowSize2 = window.getSize();
-                PauseMenu::render(debugShader, settings, (int)windowSize2.x, (int)windowSize2.y);
+                // Render pause menu
+                if (PauseMenu::isOpen()) {
+                    PauseMenu::render(settings, (int)windowSize2.x, (int)windowSize2.y);
+                }
+            
+                if (Profiler::isOverlayVisible()) {
+                    SimpleHUD::renderProfilerOverlay();
+                }
+
+                UIBatch::end();
+                Profiler::endGpu(GpuTimer::UI);
             }
         }
 
-        window.swapBuffers();
+        UploadRing::endFrame();
+        {
+            PROFILE_SCOPE("SwapBuffers");
+            window.swapBuffers();
+        }
         window.pollEvents();
+        Profiler::endFrame();
+        
+        if (timedemoMode) {
+            timedemo.addFrame(((float)glfwGetTime() - currentFrame) * 1000.0f);
+            timedemo.addChunkLoads(world->takeChunkLoadTimes());
+            if (timedemo.getFrameCount() % 30 == 1) {
+                timedemo.sampleMemory();
+            }
+        }
+    }
+    
+    recorder.stop();
+    if (timedemoMode) {
+        timedemo.sampleMemory();
+        if (world && camera) {
+            timedemo.setRaycastRate(Raycast::measureRaysPerSecond(*world, camera->getPosition(),
+                                                                  TimeDemo::RAYCAST_BENCHMARK_RAYS, 64.0f));
+        }
+        timedemo.setChunkPoolStats(ChunkPool::getStats());
+        timedemo.printReport(std::cout);
     }
 
     // Save world before exit
@@ -372,20 +623,26 @@ int main() {
         world->saveAllChunks();
     }
     
-    // Save settings before exit
-    settings.saveToFile();
+    // Save settings before exit (a timedemo replaced them with the defaults)
+    if (!timedemoMode) {
+        settings.saveToFile();
+    }
     
     // Cleanup game objects
     if (world) delete world;
     if (inventory) delete inventory;
     if (playerStats) delete playerStats;
     if (camera) delete camera;
+    JobSystem::shutdown();
     
     // Cleanup UI
-    MainMenu::cleanup();
-    PauseMenu::cleanup();
-    SimpleHUD::cleanup();
+    ChunkPool::cleanup();
+    Mesh::cleanup();
+    UploadRing::cleanup();
+    UIBatch::cleanup();
     DebugRenderer::cleanup();
+    FrameUniforms::cleanup();
+    Profiler::cleanup();
     glDeleteTextures(1, &texture);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "AssetLoader.h"
+#include "UIBatch.h"
+#include "core/Window.h"
+#include <glad/glad.h>
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+Window* AssetLoader::s_window = nullptr;
+int AssetLoader::s_stepCount = 0;
+std::vector<AssetLoader::StartupStep> AssetLoader::s_steps;
+uint64_t AssetLoader::s_startNs = 0;
+uint64_t AssetLoader::s_stepStartNs = 0;
+uint64_t AssetLoader::s_stepWaitNs = 0;
+uint64_t AssetLoader::s_lastDrawNs = 0;
+
+std::future<ImageData> AssetLoader::loadImage(const std::string& path) {
+    // The flip flag is global in stb_image; set it here, before any worker reads it
+    stbi_set_flip_vertically_on_load(true);
+    return std::async(std::launch::async, [path]() {
+        ImageData image;
+        unsigned char* data = stbi_load(path.c_str(), &image.width, &image.height, &image.channels, 0);
+        if (!data) {
+            std::cerr << "Failed to load image: " << path << std::endl;
+            return image;
+        }
+        image.pixels.assign(data, data + (size_t)image.width * image.height * image.channels);
+        stbi_image_free(data);
+        return image;
+    });
+}
+
+std::future<ShaderSources> AssetLoader::loadShaderSources(const std::string& vertexPath, const std::string& fragmentPath) {
+    return std::async(std::launch::async, [vertexPath, fragmentPath]() {
+        return Shader::loadSources(vertexPath, fragmentPath);
+    });
+}
+
+void AssetLoader::beginStartup(Window& window, int stepCount, uint64_t startNs) {
+    s_window = &window;
+    s_stepCount = stepCount;
+    s_steps.clear();
+    s_startNs = startNs;
+    s_lastDrawNs = 0;
+
+    uint64_t now = Profiler::nowNs();
+    s_steps.push_back({"Window", now - startNs, 0});
+    s_stepStartNs = now;
+    s_stepWaitNs = 0;
+}
+
+void AssetLoader::completeStep(const char* name) {
+    uint64_t now = Profiler::nowNs();
+    s_steps.push_back({name, now - s_stepStartNs, s_stepWaitNs});
+    renderProgress();
+
+    // The redraw is startup time too, but not part of the next step
+    s_stepStartNs = Profiler::nowNs();
+    s_stepWaitNs = 0;
+}
+
+void AssetLoader::renderProgress() {
+    uint64_t now = Profiler::nowNs();
+    if (!s_window || (s_lastDrawNs != 0 && now - s_lastDrawNs < PROGRESS_REDRAW_NS)) {
+        return;
+    }
+    s_lastDrawNs = now;
+
+    glm::vec2 size = s_window->getSize();
+    float progress = s_stepCount > 0 ? std::min(1.0f, (float)(s_steps.size() - 1) / s_stepCount) : 1.0f;
+    float barWidth = size.x * 0.4f;
+    float barHeight = 16.0f;
+    float barX = (size.x - barWidth) * 0.5f;
+    float barY = size.y * 0.6f;
+
+    glClearColor(0.53f, 0.81f, 0.92f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    UIBatch::begin((int)size.x, (int)size.y);
+    UIBatch::drawQuad(barX - 2.0f, barY - 2.0f, barWidth + 4.0f, barHeight + 4.0f, glm::vec3(0.1f), 0.8f);
+    UIBatch::drawQuad(barX, barY, barWidth * progress, barHeight, glm::vec3(0.3f, 0.8f, 0.3f));
+    UIBatch::end();
+
+    s_window->swapBuffers();
+    s_window->pollEvents();
+}
+
+void AssetLoader::endStartup() {
+    uint64_t totalNs = Profiler::nowNs() - s_startNs;
+    uint64_t stepsNs = 0;
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+    out << "=== Startup ===" << "\n";
+    for (const StartupStep& step : s_steps) {
+        stepsNs += step.totalNs;
+        out << "  " << std::left << std::setw(20) << step.name << std::right << std::setw(8)
+            << step.totalNs / 1.0e6 << " ms";
+        if (step.waitNs > 0) {
+            out << " (" << step.waitNs / 1.0e6 << " ms waiting on workers)";
+        }
+        out << "\n";
+    }
+    out << "  " << std::left << std::setw(20) << "Progress screen" << std::right << std::setw(8)
+        << (totalNs - stepsNs) / 1.0e6 << " ms\n";
+    out << "Shaders:  " << Shader::getProgramCount() << " programs, "
+        << Shader::getCachedProgramCount() << " from binary cache\n";
+    out << "STARTUP total_ms=" << totalNs / 1.0e6 << "\n";
+    std::cout << out.str() << std::flush;
+
+    s_window = nullptr;
+}
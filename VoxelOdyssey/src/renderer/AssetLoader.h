@@ -0,0 +1,65 @@
+#pragma once
+#include "Shader.h"
+#include "core/Profiler.h"
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+class Window;
+
+// Decoded 8-bit image, rows bottom-up (GL convention)
+struct ImageData {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    std::vector<unsigned char> pixels;
+
+    bool isValid() const { return !pixels.empty(); }
+};
+
+// Startup asset loading. File reads, image decoding and procedural texture data are
+// CPU-only, so they start on worker threads (std::async) the moment they are requested.
+// The main thread, which owns the GL context, then waits for each result in turn,
+// uploads it and redraws a progress bar. Every step is timed for the startup report.
+class AssetLoader {
+public:
+    static std::future<ImageData> loadImage(const std::string& path);
+    static std::future<ShaderSources> loadShaderSources(const std::string& vertexPath, const std::string& fragmentPath);
+    // Any other job that touches no GL state
+    template<typename Job>
+    static auto run(Job job) { return std::async(std::launch::async, std::move(job)); }
+
+    // Main thread only. startNs is when startup began; the time up to this call is
+    // reported as the window step.
+    static void beginStartup(Window& window, int stepCount, uint64_t startNs);
+    // Time spent blocked here counts as waiting on workers for the current step
+    template<typename T>
+    static T wait(std::future<T>& future) {
+        uint64_t waitStartNs = Profiler::nowNs();
+        T result = future.get();
+        s_stepWaitNs += Profiler::nowNs() - waitStartNs;
+        return result;
+    }
+    static void completeStep(const char* name);
+    static void endStartup();
+
+private:
+    struct StartupStep {
+        const char* name;
+        uint64_t totalNs;
+        uint64_t waitNs;
+    };
+
+    static constexpr uint64_t PROGRESS_REDRAW_NS = 100000000;  // Each redraw can block on vsync
+
+    static Window* s_window;
+    static int s_stepCount;
+    static std::vector<StartupStep> s_steps;
+    static uint64_t s_startNs;
+    static uint64_t s_stepStartNs;
+    static uint64_t s_stepWaitNs;
+    static uint64_t s_lastDrawNs;
+
+    static void renderProgress();
+};
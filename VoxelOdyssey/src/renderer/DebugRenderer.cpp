@@ -54,8 +54,7 @@ void DebugRenderer::cleanup() {
     s_initialized = false;
 }
 
-void DebugRenderer::renderBlockOutline(Shader& shader, const glm::ivec3& blockPos, 
-                                       const glm::mat4& view, const glm::mat4& projection) {
+void DebugRenderer::renderBlockOutline(Shader& shader, const glm::ivec3& blockPos) {
     if (!s_initialized) {
         init();
     }
@@ -66,8 +65,6 @@ void DebugRenderer::renderBlockOutline(Shader& shader, const glm::ivec3& blockPo
     
     shader.use();
     shader.setMat4("model", model);
-    shader.setMat4("view", view);
-    shader.setMat4("projection", projection);
     shader.setVec3("color", glm::vec3(1.0f, 1.0f, 0.0f)); // Yellow outline
     
     // Enable wireframe mode
@@ -7,7 +7,7 @@ class DebugRenderer {
 public:
     static void init();
     static void cleanup();
-    static void renderBlockOutline(Shader& shader, const glm::ivec3& blockPos, const glm::mat4& view, const glm::mat4& projection);
+    static void renderBlockOutline(Shader& shader, const glm::ivec3& blockPos);
     
 private:
     static unsigned int s_VAO, s_VBO;
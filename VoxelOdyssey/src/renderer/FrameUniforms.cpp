@@ -0,0 +1,42 @@
+#include "FrameUniforms.h"
+#include <glad/glad.h>
+
+unsigned int FrameUniforms::s_UBO = 0;
+bool FrameUniforms::s_initialized = false;
+
+void FrameUniforms::init() {
+    if (s_initialized) return;
+    
+    glGenBuffers(1, &s_UBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, s_UBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    
+    glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_POINT, s_UBO);
+    s_initialized = true;
+}
+
+void FrameUniforms::cleanup() {
+    if (!s_initialized) return;
+    
+    glDeleteBuffers(1, &s_UBO);
+    s_UBO = 0;
+    s_initialized = false;
+}
+
+void FrameUniforms::update(const glm::mat4& view, const glm::mat4& projection,
+                           const glm::vec3& viewPos, const glm::vec3& lightPos,
+                           const glm::vec3& lightColor) {
+    if (!s_initialized) init();
+    
+    FrameData data;
+    data.view = view;
+    data.projection = projection;
+    data.viewPos = glm::vec4(viewPos, 1.0f);
+    data.lightPos = glm::vec4(lightPos, 1.0f);
+    data.lightColor = glm::vec4(lightColor, 1.0f);
+    
+    glBindBuffer(GL_UNIFORM_BUFFER, s_UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Per-frame constants, laid out to match the std140 "FrameData" block
+// declared by the world, skybox and debug shaders
+struct FrameData {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec4 viewPos;     // w unused (std140 pads vec3 to 16 bytes)
+    glm::vec4 lightPos;
+    glm::vec4 lightColor;
+};
+
+static_assert(sizeof(FrameData) == 176, "FrameData must match the std140 layout");
+
+class FrameUniforms {
+public:
+    static constexpr unsigned int BINDING_POINT = 0;
+    static constexpr const char* BLOCK_NAME = "FrameData";
+    
+    static void init();
+    static void cleanup();
+    
+    // Upload this frame's constants once; every shader reads them from the bound block
+    static void update(const glm::mat4& view, const glm::mat4& projection,
+                       const glm::vec3& viewPos, const glm::vec3& lightPos,
+                       const glm::vec3& lightColor);
+    
+private:
+    static unsigned int s_UBO;
+    static bool s_initialized;
+};
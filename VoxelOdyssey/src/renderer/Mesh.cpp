@@ -1,38 +1,96 @@
 #include "Mesh.h"
+#include "UploadRing.h"
+#include "core/Profiler.h"
+#include <cstdint>
 
-Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) 
-    : m_VAO(0), m_VBO(0), m_EBO(0), m_vertexCount(0), m_indexCount(0) {
-    setupMesh(vertices, indices);
+unsigned int Mesh::s_quadIndices16 = 0;
+unsigned int Mesh::s_quadIndices32 = 0;
+unsigned int Mesh::s_quadCapacity32 = 0;
+
+// Room left for growth when a buffer has to be reallocated, so the next few edits
+// that add faces still fit
+static unsigned int withHeadroom(size_t count) {
+    return static_cast<unsigned int>(count + count / 4);
+}
+
+// The same two triangles for every quad: 0 1 2, 0 2 3
+template <typename Index>
+static std::vector<Index> buildQuadIndices(unsigned int quadCount) {
+    std::vector<Index> indices(quadCount * 6);
+    for (unsigned int i = 0; i < quadCount; i++) {
+        Index base = static_cast<Index>(i * 4);
+        indices[i * 6 + 0] = base;
+        indices[i * 6 + 1] = base + 1;
+        indices[i * 6 + 2] = base + 2;
+        indices[i * 6 + 3] = base;
+        indices[i * 6 + 4] = base + 2;
+        indices[i * 6 + 5] = base + 3;
+    }
+    return indices;
+}
+
+Mesh::Mesh() 
+    : m_VAO(0), m_VBO(0), m_vertexCount(0), m_indexCount(0), m_vertexCapacity(0),
+      m_indexType(GL_UNSIGNED_SHORT) {
+}
+
+Mesh::Mesh(const MeshData& data) 
+    : m_VAO(0), m_VBO(0), m_vertexCount(0), m_indexCount(0), m_vertexCapacity(0),
+      m_indexType(GL_UNSIGNED_SHORT) {
+    updateMesh(data);
 }
 
 Mesh::~Mesh() {
     if (m_VAO != 0) {
         glDeleteVertexArrays(1, &m_VAO);
         glDeleteBuffers(1, &m_VBO);
-        glDeleteBuffers(1, &m_EBO);
     }
 }
 
-void Mesh::setupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
-    m_vertexCount = vertices.size();
-    m_indexCount = indices.size();
-    
-    if (m_vertexCount == 0) {
-        return;
+void Mesh::cleanup() {
+    glDeleteBuffers(1, &s_quadIndices16);
+    glDeleteBuffers(1, &s_quadIndices32);
+    s_quadIndices16 = 0;
+    s_quadIndices32 = 0;
+    s_quadCapacity32 = 0;
+}
+
+GLenum Mesh::bindQuadIndices(unsigned int quadCount) {
+    if (quadCount <= MAX_QUADS_16BIT) {
+        // Built once at full size; covers every mesh below the 16-bit limit
+        if (s_quadIndices16 == 0) {
+            std::vector<uint16_t> indices = buildQuadIndices<uint16_t>(MAX_QUADS_16BIT);
+            glGenBuffers(1, &s_quadIndices16);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_quadIndices16);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+        } else {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_quadIndices16);
+        }
+        return GL_UNSIGNED_SHORT;
     }
     
+    // Only very busy meshes get here; the 32-bit buffer grows to the largest one seen.
+    // It keeps its name when it grows, so meshes already using it see the new storage.
+    if (s_quadIndices32 == 0) {
+        glGenBuffers(1, &s_quadIndices32);
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_quadIndices32);
+    if (quadCount > s_quadCapacity32) {
+        s_quadCapacity32 = withHeadroom(quadCount);
+        std::vector<uint32_t> indices = buildQuadIndices<uint32_t>(s_quadCapacity32);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+    }
+    return GL_UNSIGNED_INT;
+}
+
+void Mesh::createBuffers() {
     glGenVertexArrays(1, &m_VAO);
     glGenBuffers(1, &m_VBO);
-    glGenBuffers(1, &m_EBO);
     
     glBindVertexArray(m_VAO);
-    
     glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
-    
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
     
+    // The layout refers to the buffer object, not its storage, so it survives reallocation
     // Position attribute
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
     glEnableVertexAttribArray(0);
@@ -49,16 +107,55 @@ void Mesh::setupMesh(const std::vector<Vertex>& vertices, const std::vector<unsi
     glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, ao));
     glEnableVertexAttribArray(3);
     
+    // Light attribute
+    glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, light));
+    glEnableVertexAttribArray(4);
+    
     glBindVertexArray(0);
 }
 
-void Mesh::updateMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
-    if (m_VAO != 0) {
-        glDeleteVertexArrays(1, &m_VAO);
-        glDeleteBuffers(1, &m_VBO);
-        glDeleteBuffers(1, &m_EBO);
+void Mesh::updateMesh(const MeshData& data) {
+    unsigned int quadCount = static_cast<unsigned int>(data.getQuadCount());
+    m_vertexCount = quadCount * 4;
+    m_indexCount = quadCount * 6;
+    
+    if (m_vertexCount == 0) {
+        // Keep the buffers; an emptied chunk usually gets blocks again soon
+        return;
+    }
+    
+    if (m_VAO == 0) {
+        createBuffers();
     }
-    setupMesh(vertices, indices);
+    
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    
+    // Reallocate when the data doesn't fit, or when it uses less than a quarter of the
+    // buffer (a chunk that was mostly dug out shouldn't hold on to its memory)
+    bool reallocate = m_vertexCount > m_vertexCapacity || m_vertexCount < m_vertexCapacity / 4;
+    if (reallocate) {
+        m_vertexCapacity = withHeadroom(m_vertexCount);
+        glBufferData(GL_ARRAY_BUFFER, m_vertexCapacity * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+    }
+    
+    // Normally staged through the upload ring and copied GPU-side. Once this frame's
+    // ring budget is spent, upload directly, orphaning the old storage first
+    // (glBufferData with no data) so the driver doesn't wait for draws still reading it.
+    size_t bytes = m_vertexCount * sizeof(Vertex);
+    if (!UploadRing::upload(m_VBO, 0, data.vertices.data(), bytes)) {
+        if (!reallocate) {
+            glBufferData(GL_ARRAY_BUFFER, m_vertexCapacity * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, data.vertices.data());
+        Profiler::increment(ProfileCounter::UPLOAD_BYTES_DIRECT, static_cast<int64_t>(bytes));
+    }
+    
+    // The element buffer binding is VAO state, so this attaches it to the mesh
+    m_indexType = bindQuadIndices(quadCount);
+    glBindVertexArray(0);
+    
+    Profiler::increment(ProfileCounter::CHUNKS_UPLOADED);
 }
 
 void Mesh::draw() const {
@@ -67,7 +164,6 @@ void Mesh::draw() const {
     }
     
     glBindVertexArray(m_VAO);
-    glDrawElements(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, m_indexCount, m_indexType, 0);
     glBindVertexArray(0);
 }
-
@@ -9,23 +9,66 @@ struct Vertex {
     glm::vec3 normal;
     glm::vec2 texCoord;
     float ao; // Ambient occlusion value (0.0 = darkest, 1.0 = brightest)
+    glm::vec2 light; // Sky and block light in front of the face (0.0-1.0)
+};
+
+// CPU side of a mesh: quads of four vertices (v0 v1 v2 v3, drawn as v0 v1 v2 and
+// v0 v2 v3). Indices come from a buffer shared by every mesh, so none are stored here.
+// Move-only so a finished mesh is never copied on its way to the GPU; clear() keeps
+// the capacity so a scratch instance can be refilled without touching the heap.
+struct MeshData {
+    std::vector<Vertex> vertices;
+    
+    MeshData() = default;
+    MeshData(MeshData&&) = default;
+    MeshData& operator=(MeshData&&) = default;
+    MeshData(const MeshData&) = delete;
+    MeshData& operator=(const MeshData&) = delete;
+    
+    void clear() { vertices.clear(); }
+    void reserveQuads(size_t quadCount) { vertices.reserve(quadCount * 4); }
+    
+    size_t getQuadCount() const { return vertices.size() / 4; }
+    bool empty() const { return vertices.empty(); }
 };
 
 class Mesh {
 public:
-    Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    // Quads addressable with 16-bit indices; larger meshes fall back to 32-bit ones
+    static constexpr unsigned int MAX_QUADS_16BIT = 65536 / 4;
+    
+    Mesh();
+    explicit Mesh(const MeshData& data);
     ~Mesh();
     
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+    
     void draw() const;
-    void updateMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    // Upload new contents (through UploadRing when it has room). The GL objects live as
+    // long as the mesh; the vertex buffer is only reallocated when the data doesn't fit.
+    void updateMesh(const MeshData& data);
     
     bool isEmpty() const { return m_vertexCount == 0; }
+    unsigned int getVertexCount() const { return m_vertexCount; }
+    unsigned int getIndexCount() const { return m_indexCount; }
+    
+    // Delete the shared quad index buffers (call before the GL context goes away)
+    static void cleanup();
     
 private:
-    unsigned int m_VAO, m_VBO, m_EBO;
+    unsigned int m_VAO, m_VBO;
     unsigned int m_vertexCount;
     unsigned int m_indexCount;
+    unsigned int m_vertexCapacity;  // Allocated vertex buffer size, in vertices
+    GLenum m_indexType;             // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
     
-    void setupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    static unsigned int s_quadIndices16;
+    static unsigned int s_quadIndices32;
+    static unsigned int s_quadCapacity32;  // Quads covered by s_quadIndices32
+    
+    void createBuffers();
+    // Attach a shared index buffer covering quadCount quads to the bound VAO and
+    // return its index type
+    static GLenum bindQuadIndices(unsigned int quadCount);
 };
-
@@ -1,13 +1,153 @@
 #include "Shader.h"
+#include "FrameUniforms.h"
+#include "core/Profiler.h"
 #include <fstream>
 #include <sstream>
 #include <glad/glad.h>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
 
-Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
-    std::string vShaderCode = loadShader(vertexPath);
-    std::string fShaderCode = loadShader(fragmentPath);
-    compile(vShaderCode, fShaderCode);
+unsigned int Shader::s_boundProgram = 0;
+int Shader::s_programCount = 0;
+int Shader::s_cachedProgramCount = 0;
+float Shader::s_buildTimeMs = 0.0f;
+
+static const char* SHADER_CACHE_DIRECTORY = "shadercache/";
+static constexpr uint32_t SHADER_CACHE_MAGIC = 0x42534F56;  // "VOSB"
+
+// 64-bit FNV-1a, chained through seed so several strings hash as one
+static uint64_t hashString(const std::string& str, uint64_t seed = 1469598103934665603ull) {
+    uint64_t hash = seed;
+    for (unsigned char c : str) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static std::string getGLString(GLenum name) {
+    const GLubyte* str = glGetString(name);
+    return str ? reinterpret_cast<const char*>(str) : "";
+}
+
+// Program binaries need GL 4.1 or ARB_get_program_binary; the 3.3 context only has them
+// as an extension, so without it every program is compiled from source
+static bool isProgramBinarySupported() {
+    if (!GLAD_GL_VERSION_4_1 && !GLAD_GL_ARB_get_program_binary) {
+        return false;
+    }
+    return glProgramBinary != nullptr && glGetProgramBinary != nullptr && glProgramParameteri != nullptr;
+}
+
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, const ShaderDefines& defines)
+    : Shader(loadSources(vertexPath, fragmentPath), defines) {
+}
+
+Shader::Shader(const ShaderSources& sources, const ShaderDefines& defines) {
+    uint64_t startNs = Profiler::nowNs();
+    compile(applyDefines(sources.vertex, defines), applyDefines(sources.fragment, defines));
+    s_buildTimeMs += (Profiler::nowNs() - startNs) / 1.0e6f;
+}
+
+ShaderSources Shader::loadSources(const std::string& vertexPath, const std::string& fragmentPath) {
+    return ShaderSources{loadShader(vertexPath), loadShader(fragmentPath)};
+}
+
+Shader::~Shader() {
+    if (s_boundProgram == ID) {
+        s_boundProgram = 0;
+    }
+    glDeleteProgram(ID);
+}
+
+std::string Shader::applyDefines(const std::string& source, const ShaderDefines& defines) {
+    if (defines.empty()) {
+        return source;
+    }
+    
+    // #version has to stay first; #line keeps compile errors pointing at the file's lines
+    size_t versionEnd = source.rfind("#version", 0) == 0 ? source.find('\n') : std::string::npos;
+    size_t insertAt = versionEnd == std::string::npos ? 0 : versionEnd + 1;
+    std::string block;
+    for (const std::string& define : defines) {
+        block += "#define " + define + "\n";
+    }
+    block += "#line " + std::to_string(insertAt > 0 ? 2 : 1) + "\n";
+    return source.substr(0, insertAt) + block + source.substr(insertAt);
+}
+
+std::string Shader::getCachePath(const std::string& vertexSource, const std::string& fragmentSource) {
+    if (!isProgramBinarySupported()) {
+        return "";
+    }
+    
+    // Binaries only load on the driver that produced them
+    int formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount <= 0 || vertexSource.empty() || fragmentSource.empty()) {
+        return "";
+    }
+    
+    uint64_t hash = hashString(vertexSource);
+    hash = hashString(fragmentSource, hash);
+    hash = hashString(getGLString(GL_VENDOR), hash);
+    hash = hashString(getGLString(GL_RENDERER), hash);
+    hash = hashString(getGLString(GL_VERSION), hash);
+    
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(hash));
+    return std::string(SHADER_CACHE_DIRECTORY) + name;
+}
+
+bool Shader::loadBinary(const std::string& cachePath) {
+    std::ifstream file(cachePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    uint32_t header[2] = {0, 0};  // Magic, binary format
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    std::vector<char> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!file.good() && !file.eof()) return false;
+    if (header[0] != SHADER_CACHE_MAGIC || binary.empty()) return false;
+    
+    ID = glCreateProgram();
+    glProgramBinary(ID, header[1], binary.data(), static_cast<GLsizei>(binary.size()));
+    
+    // Drivers reject binaries from older versions of themselves; rebuild from source then
+    int success = 0;
+    glGetProgramiv(ID, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(ID);
+        ID = 0;
+        return false;
+    }
+    return true;
+}
+
+void Shader::saveBinary(const std::string& cachePath) const {
+    int length = 0;
+    glGetProgramiv(ID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(ID, length, nullptr, &format, binary.data());
+    
+    std::error_code ec;
+    std::filesystem::create_directories(SHADER_CACHE_DIRECTORY, ec);
+    std::ofstream file(cachePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Shader cache write failed: " << cachePath << std::endl;
+        return;
+    }
+    uint32_t header[2] = {SHADER_CACHE_MAGIC, static_cast<uint32_t>(format)};
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(binary.data(), binary.size());
 }
 
 std::string Shader::loadShader(const std::string& path) {
@@ -44,12 +184,24 @@ unsigned int Shader::compileShader(const std::string& source, unsigned int type)
 }
 
 void Shader::compile(const std::string& vertexSource, const std::string& fragmentSource) {
+    s_programCount++;
+    std::string cachePath = getCachePath(vertexSource, fragmentSource);
+    if (!cachePath.empty() && loadBinary(cachePath)) {
+        s_cachedProgramCount++;
+        cacheUniformLocations();
+        bindUniformBlocks();
+        return;
+    }
+    
     unsigned int vertex = compileShader(vertexSource, GL_VERTEX_SHADER);
     unsigned int fragment = compileShader(fragmentSource, GL_FRAGMENT_SHADER);
 
     ID = glCreateProgram();
     glAttachShader(ID, vertex);
     glAttachShader(ID, fragment);
+    if (!cachePath.empty()) {
+        glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(ID);
 
     int success;
@@ -58,26 +210,98 @@ void Shader::compile(const std::string& vertexSource, const std::string& fragmen
         char infoLog[512];
         glGetProgramInfoLog(ID, 512, nullptr, infoLog);
         std::cerr << "Program link failed:\n" << infoLog << std::endl;
+    } else if (!cachePath.empty()) {
+        saveBinary(cachePath);
     }
 
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+    
+    cacheUniformLocations();
+    bindUniformBlocks();
+}
+
+void Shader::cacheUniformLocations() {
+    uniformCache.clear();
+    
+    int uniformCount = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &uniformCount);
+    
+    char name[256];
+    for (int i = 0; i < uniformCount; i++) {
+        int length = 0;
+        int size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(ID, i, sizeof(name), &length, &size, &type, name);
+        
+        // Members of uniform blocks have no location
+        int location = glGetUniformLocation(ID, name);
+        if (location < 0) continue;
+        
+        // Arrays are reported as "name[0]"; cache them under the base name too
+        std::string uniformName(name, length);
+        size_t bracket = uniformName.find('[');
+        if (bracket != std::string::npos) {
+            uniformCache[uniformName.substr(0, bracket)] = location;
+        }
+        uniformCache[uniformName] = location;
+    }
 }
 
-void Shader::use() { glUseProgram(ID); }
+void Shader::bindUniformBlocks() {
+    unsigned int blockIndex = glGetUniformBlockIndex(ID, FrameUniforms::BLOCK_NAME);
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(ID, blockIndex, FrameUniforms::BINDING_POINT);
+    }
+}
 
-void Shader::setMat4(const std::string& name, const glm::mat4& mat) const {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::use() {
+    if (s_boundProgram == ID) return;
+    glUseProgram(ID);
+    s_boundProgram = ID;
 }
 
-void Shader::setVec3(const std::string& name, const glm::vec3& value) const {
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+int Shader::getUniformLocation(const std::string& name) const {
+    auto it = uniformCache.find(name);
+    return it != uniformCache.end() ? it->second : -1;
 }
 
-void Shader::setInt(const std::string& name, int value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+void Shader::set(Uniform<glm::mat4> uniform, const glm::mat4& mat) const {
+    glUniformMatrix4fv(uniform.location, 1, GL_FALSE, &mat[0][0]);
+}
+
+void Shader::set(Uniform<glm::vec2> uniform, const glm::vec2& value) const {
+    glUniform2fv(uniform.location, 1, &value[0]);
+}
+
+void Shader::set(Uniform<glm::vec3> uniform, const glm::vec3& value) const {
+    glUniform3fv(uniform.location, 1, &value[0]);
+}
+
+void Shader::set(Uniform<glm::vec4> uniform, const glm::vec4& value) const {
+    glUniform4fv(uniform.location, 1, &value[0]);
+}
+
+void Shader::set(Uniform<int> uniform, int value) const {
+    glUniform1i(uniform.location, value);
+}
+
+void Shader::setMat4(const std::string& name, const glm::mat4& mat) const {
+    set(Uniform<glm::mat4>{getUniformLocation(name)}, mat);
 }
 
+void Shader::setVec2(const std::string& name, const glm::vec2& value) const {
+    set(Uniform<glm::vec2>{getUniformLocation(name)}, value);
+}
 
+void Shader::setVec3(const std::string& name, const glm::vec3& value) const {
+    set(Uniform<glm::vec3>{getUniformLocation(name)}, value);
+}
 
+void Shader::setVec4(const std::string& name, const glm::vec4& value) const {
+    set(Uniform<glm::vec4>{getUniformLocation(name)}, value);
+}
 
+void Shader::setInt(const std::string& name, int value) const {
+    set(Uniform<int>{getUniformLocation(name)}, value);
+}
@@ -1,22 +1,80 @@
 #pragma once
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 
+// Typed handle to a uniform location, resolved once and reused every frame
+template<typename T>
+struct Uniform {
+    int location = -1;
+    bool isValid() const { return location >= 0; }
+};
 
+// Feature switches for one variant of a shader. Each name becomes a "#define NAME"
+// right after the #version line of both stages.
+using ShaderDefines = std::vector<std::string>;
+
+// Both stages of a program as read from disk. Reading touches no GL state, so sources
+// can be loaded on a worker thread and handed to the GL thread to build.
+struct ShaderSources {
+    std::string vertex;
+    std::string fragment;
+};
+
+// Linked programs are cached on disk (glGetProgramBinary) under a hash of the final
+// sources and the driver, so later runs skip compiling and linking. A stale or rejected
+// binary just falls back to building from source and is overwritten.
 class Shader {
-    public: 
+    public:
         unsigned int ID;
-        Shader(const std::string& vertexPath, const std::string& fragmentPath);
+        Shader(const std::string& vertexPath, const std::string& fragmentPath,
+               const ShaderDefines& defines = {});
+        explicit Shader(const ShaderSources& sources, const ShaderDefines& defines = {});
+        ~Shader();
+        Shader(const Shader&) = delete;
+        Shader& operator=(const Shader&) = delete;
         void use();
+
+        // Locations are cached at link time; unknown names resolve to -1 (ignored by GL)
+        int getUniformLocation(const std::string& name) const;
+        template<typename T>
+        Uniform<T> getUniform(const std::string& name) const { return Uniform<T>{getUniformLocation(name)}; }
+
+        void set(Uniform<glm::mat4> uniform, const glm::mat4& mat) const;
+        void set(Uniform<glm::vec2> uniform, const glm::vec2& value) const;
+        void set(Uniform<glm::vec3> uniform, const glm::vec3& value) const;
+        void set(Uniform<glm::vec4> uniform, const glm::vec4& value) const;
+        void set(Uniform<int> uniform, int value) const;
+
         void setMat4(const std::string& name, const glm::mat4& mat) const;
+        void setVec2(const std::string& name, const glm::vec2& value) const;
         void setVec3(const std::string& name, const glm::vec3& value) const;
+        void setVec4(const std::string& name, const glm::vec4& value) const;
         void setInt(const std::string& name, int value) const;
 
+        // Thread-safe; a missing file is reported and yields an empty source
+        static ShaderSources loadSources(const std::string& vertexPath, const std::string& fragmentPath);
+
+        // Programs built so far, how many came from the binary cache, and the time spent
+        static int getProgramCount() { return s_programCount; }
+        static int getCachedProgramCount() { return s_cachedProgramCount; }
+        static float getBuildTimeMs() { return s_buildTimeMs; }
+
     private:
         void compile(const std::string& vertexSource, const std::string & fragmentSource);
-        std::string loadShader(const std::string& path);
+        static std::string applyDefines(const std::string& source, const ShaderDefines& defines);
+        static std::string getCachePath(const std::string& vertexSource, const std::string& fragmentSource);
+        bool loadBinary(const std::string& cachePath);
+        void saveBinary(const std::string& cachePath) const;
+        static std::string loadShader(const std::string& path);
         unsigned int compileShader(const std::string& source, unsigned int type);
+        void cacheUniformLocations();
+        void bindUniformBlocks();
         std::unordered_map<std::string, int > uniformCache;
 
-};
\ No newline at end of file
+        static unsigned int s_boundProgram;
+        static int s_programCount;
+        static int s_cachedProgramCount;
+        static float s_buildTimeMs;
+};
@@ -1,136 +1,25 @@
 #include "SimpleHUD.h"
+#include "UIBatch.h"
 #include "world/Block.h"
-#include <glad/glad.h>
-#include <glm/gtc/matrix_transform.hpp>
+#include "core/Profiler.h"
+#include <algorithm>
 
-bool SimpleHUD::s_initialized = false;
-unsigned int SimpleHUD::s_lineVAO = 0;
-unsigned int SimpleHUD::s_lineVBO = 0;
-unsigned int SimpleHUD::s_quadVAO = 0;
-unsigned int SimpleHUD::s_quadVBO = 0;
-
-void SimpleHUD::setupLineVAO() {
-    float vertices[] = {
-        0.0f, 0.0f, 0.0f,
-        1.0f, 0.0f, 0.0f
-    };
-    
-    glGenVertexArrays(1, &s_lineVAO);
-    glGenBuffers(1, &s_lineVBO);
-    
-    glBindVertexArray(s_lineVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, s_lineVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-    
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    glBindVertexArray(0);
-}
-
-void SimpleHUD::setupQuadVAO() {
-    float vertices[] = {
-        0.0f, 0.0f, 0.0f,
-        1.0f, 0.0f, 0.0f,
-        1.0f, 1.0f, 0.0f,
-        0.0f, 1.0f, 0.0f
-    };
-    
-    unsigned int indices[] = {
-        0, 1, 2,
-        0, 2, 3
-    };
-    
-    unsigned int EBO;
-    glGenVertexArrays(1, &s_quadVAO);
-    glGenBuffers(1, &s_quadVBO);
-    glGenBuffers(1, &EBO);
-    
-    glBindVertexArray(s_quadVAO);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, s_quadVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-    
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-    
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    glBindVertexArray(0);
-    glDeleteBuffers(1, &EBO);
-}
-
-void SimpleHUD::init() {
-    if (s_initialized) return;
-    
-    setupLineVAO();
-    setupQuadVAO();
-    
-    s_initialized = true;
-}
-
-void SimpleHUD::cleanup() {
-    if (!s_initialized) return;
-    
-    glDeleteVertexArrays(1, &s_lineVAO);
-    glDeleteBuffers(1, &s_lineVBO);
-    glDeleteVertexArrays(1, &s_quadVAO);
-    glDeleteBuffers(1, &s_quadVBO);
-    
-    s_initialized = false;
-}
-
-void SimpleHUD::renderCrosshair(Shader& shader, int windowWidth, int windowHeight) {
-    if (!s_initialized) init();
-    
-    // Use orthographic projection for 2D rendering
-    glm::mat4 projection = glm::ortho(0.0f, (float)windowWidth, (float)windowHeight, 0.0f, -1.0f, 1.0f);
-    glm::mat4 view = glm::mat4(1.0f);
-    
+void SimpleHUD::renderCrosshair(int windowWidth, int windowHeight) {
     float centerX = windowWidth / 2.0f;
     float centerY = windowHeight / 2.0f;
     float size = 15.0f;
     float thickness = 2.0f;
-    
-    shader.use();
-    // Set color uniform if it exists (debug shader has color uniform)
-    shader.setVec3("color", glm::vec3(1.0f, 1.0f, 1.0f)); // White
-    
-    glDisable(GL_DEPTH_TEST);
-    glLineWidth(thickness);
+    glm::vec3 color(1.0f, 1.0f, 1.0f); // White
     
     // Horizontal line
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(centerX - size, centerY, 0.0f));
-    model = glm::scale(model, glm::vec3(size * 2, thickness, 1.0f));
-    
-    shader.setMat4("model", model);
-    shader.setMat4("view", view);
-    shader.setMat4("projection", projection);
-    
-    glBindVertexArray(s_lineVAO);
-    glDrawArrays(GL_LINES, 0, 2);
+    UIBatch::drawLine(centerX - size, centerY, centerX + size, centerY, thickness, color);
     
     // Vertical line
-    model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(centerX, centerY - size, 0.0f));
-    model = glm::scale(model, glm::vec3(thickness, size * 2, 1.0f));
-    
-    shader.setMat4("model", model);
-    glDrawArrays(GL_LINES, 0, 2);
-    
-    glBindVertexArray(0);
-    glEnable(GL_DEPTH_TEST);
+    UIBatch::drawLine(centerX, centerY - size, centerX, centerY + size, thickness, color);
 }
 
-void SimpleHUD::renderBlockIndicator(Shader& shader, int selectedBlock, int windowWidth, int windowHeight) {
-    if (!s_initialized) init();
-    
+void SimpleHUD::renderBlockIndicator(int selectedBlock, int windowWidth, int windowHeight) {
     // Render a simple colored box in the bottom-right corner showing selected block
-    glm::mat4 projection = glm::ortho(0.0f, (float)windowWidth, (float)windowHeight, 0.0f, -1.0f, 1.0f);
-    glm::mat4 view = glm::mat4(1.0f);
-    
     float boxSize = 60.0f;
     float margin = 20.0f;
     float x = windowWidth - boxSize - margin;
@@ -149,67 +38,23 @@ void SimpleHUD::renderBlockIndicator(Shader& shader, int selectedBlock, int wind
         default: color = glm::vec3(0.5f, 0.5f, 0.5f); break;
     }
     
-    shader.use();
-    shader.setVec3("color", color);
-    
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(x, y, 0.0f));
-    model = glm::scale(model, glm::vec3(boxSize, boxSize, 1.0f));
-    
-    shader.setMat4("model", model);
-    shader.setMat4("view", view);
-    shader.setMat4("projection", projection);
-    
-    glDisable(GL_DEPTH_TEST);
-    
-    glBindVertexArray(s_quadVAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-    
-    glEnable(GL_DEPTH_TEST);
+    UIBatch::drawQuad(x, y, boxSize, boxSize, color);
 }
 
-void SimpleHUD::renderBar(Shader& shader, float value, float maxValue, float x, float y,
+void SimpleHUD::renderBar(float value, float maxValue, float x, float y,
                           float width, float height, const glm::vec3& fillColor,
-                          const glm::vec3& bgColor, int windowWidth, int windowHeight) {
-    if (!s_initialized) init();
-    
-    glm::mat4 projection = glm::ortho(0.0f, (float)windowWidth, (float)windowHeight, 0.0f, -1.0f, 1.0f);
-    glm::mat4 view = glm::mat4(1.0f);
-    
-    shader.use();
-    glDisable(GL_DEPTH_TEST);
-    
+                          const glm::vec3& bgColor) {
     // Render background
-    shader.setVec3("color", bgColor);
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(x, y, 0.0f));
-    model = glm::scale(model, glm::vec3(width, height, 1.0f));
-    
-    shader.setMat4("model", model);
-    shader.setMat4("view", view);
-    shader.setMat4("projection", projection);
-    
-    glBindVertexArray(s_quadVAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    UIBatch::drawQuad(x, y, width, height, bgColor);
     
     // Render fill
     float fillWidth = width * (value / maxValue);
     if (fillWidth > 0.0f) {
-        shader.setVec3("color", fillColor);
-        model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(x, y, 0.0f));
-        model = glm::scale(model, glm::vec3(fillWidth, height, 1.0f));
-        
-        shader.setMat4("model", model);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        UIBatch::drawQuad(x, y, fillWidth, height, fillColor);
     }
-    
-    glBindVertexArray(0);
-    glEnable(GL_DEPTH_TEST);
 }
 
-void SimpleHUD::renderHealthBar(Shader& shader, float health, int windowWidth, int windowHeight) {
+void SimpleHUD::renderHealthBar(float health, int windowHeight) {
     float barWidth = 200.0f;
     float barHeight = 20.0f;
     float margin = 20.0f;
@@ -227,10 +72,10 @@ void SimpleHUD::renderHealthBar(Shader& shader, float health, int windowWidth, i
     
     glm::vec3 bgColor(0.2f, 0.2f, 0.2f); // Dark gray background
     
-    renderBar(shader, health, 100.0f, x, y, barWidth, barHeight, fillColor, bgColor, windowWidth, windowHeight);
+    renderBar(health, 100.0f, x, y, barWidth, barHeight, fillColor, bgColor);
 }
 
-void SimpleHUD::renderHungerBar(Shader& shader, float hunger, int windowWidth, int windowHeight) {
+void SimpleHUD::renderHungerBar(float hunger, int windowHeight) {
     float barWidth = 200.0f;
     float barHeight = 20.0f;
     float margin = 20.0f;
@@ -248,6 +93,90 @@ void SimpleHUD::renderHungerBar(Shader& shader, float hunger, int windowWidth, i
     
     glm::vec3 bgColor(0.2f, 0.2f, 0.2f); // Dark gray background
     
-    renderBar(shader, hunger, 100.0f, x, y, barWidth, barHeight, fillColor, bgColor, windowWidth, windowHeight);
+    renderBar(hunger, 100.0f, x, y, barWidth, barHeight, fillColor, bgColor);
 }
 
+void SimpleHUD::renderProfilerOverlay() {
+    int frameCount = Profiler::getHistoryCount();
+    if (frameCount == 0) return;
+    
+    float margin = 10.0f;
+    float barWidth = 2.0f;
+    float graphWidth = Profiler::HISTORY_SIZE * barWidth;
+    float graphHeight = 100.0f;
+    float msToPixels = graphHeight / 50.0f; // Graph tops out at 50ms
+    float x = margin;
+    float y = margin;
+    
+    // Panel background
+    UIBatch::drawQuad(x - 4.0f, y - 4.0f, graphWidth + 8.0f, graphHeight + 124.0f, glm::vec3(0.0f), 0.6f);
+    
+    // CPU frame time graph, newest frame on the right
+    for (int i = 0; i < frameCount; i++) {
+        const FrameProfile& frame = Profiler::getFrame(i);
+        float height = std::min(frame.cpuMs * msToPixels, graphHeight);
+        
+        glm::vec3 color;
+        if (frame.cpuMs <= 1000.0f / 60.0f) {
+            color = glm::vec3(0.2f, 0.8f, 0.2f); // Green: 60fps budget
+        } else if (frame.cpuMs <= 1000.0f / 30.0f) {
+            color = glm::vec3(0.8f, 0.8f, 0.2f); // Yellow: 30fps budget
+        } else {
+            color = glm::vec3(0.8f, 0.2f, 0.2f); // Red
+        }
+        
+        float barX = x + graphWidth - (frameCount - i) * barWidth;
+        UIBatch::drawQuad(barX, y + graphHeight - height, barWidth, height, color);
+    }
+    
+    // 16.7ms and 33.3ms reference lines
+    float line60 = y + graphHeight - (1000.0f / 60.0f) * msToPixels;
+    float line30 = y + graphHeight - (1000.0f / 30.0f) * msToPixels;
+    UIBatch::drawLine(x, line60, x + graphWidth, line60, 1.0f, glm::vec3(1.0f));
+    UIBatch::drawLine(x, line30, x + graphWidth, line30, 1.0f, glm::vec3(1.0f, 0.5f, 0.5f));
+    
+    // GPU passes of the newest resolved frame, stacked left to right (full width = 16.7ms)
+    static const glm::vec3 gpuColors[GPU_TIMER_COUNT] = {
+        glm::vec3(0.4f, 0.7f, 1.0f),  // Skybox
+        glm::vec3(0.2f, 0.8f, 0.4f),  // World
+        glm::vec3(1.0f, 0.6f, 0.2f),  // UI
+        glm::vec3(0.8f, 0.3f, 0.8f)   // Mesh upload
+    };
+    const FrameProfile* gpuFrame = nullptr;
+    for (int i = frameCount - 1; i >= 0 && !gpuFrame; i--) {
+        const FrameProfile& frame = Profiler::getFrame(i);
+        for (float ms : frame.gpuMs) {
+            if (ms > 0.0f) {
+                gpuFrame = &frame;
+                break;
+            }
+        }
+    }
+    
+    float gpuY = y + graphHeight + 8.0f;
+    float gpuScale = graphWidth / (1000.0f / 60.0f);
+    UIBatch::drawQuad(x, gpuY, graphWidth, 16.0f, glm::vec3(0.2f, 0.2f, 0.2f));
+    if (gpuFrame) {
+        float gpuX = x;
+        for (int t = 0; t < GPU_TIMER_COUNT; t++) {
+            float width = std::min(gpuFrame->gpuMs[t] * gpuScale, x + graphWidth - gpuX);
+            if (width <= 0.0f) continue;
+            UIBatch::drawQuad(gpuX, gpuY, width, 16.0f, gpuColors[t]);
+            gpuX += width;
+        }
+    }
+    
+    // Counters for the last frame, each scaled against its peak over the history
+    const FrameProfile& last = Profiler::getLastFrame();
+    float counterY = gpuY + 24.0f;
+    for (int c = 0; c < PROFILE_COUNTER_COUNT; c++) {
+        int64_t peak = 0;
+        for (int i = 0; i < frameCount; i++) {
+            peak = std::max(peak, Profiler::getFrame(i).counters[c]);
+        }
+        
+        float value = last.counters[c] > 0 ? (float)last.counters[c] : 0.0f;
+        renderBar(value, peak > 0 ? (float)peak : 1.0f, x, counterY + c * 14.0f,
+                  graphWidth, 10.0f, glm::vec3(0.3f, 0.6f, 0.9f), glm::vec3(0.2f, 0.2f, 0.2f));
+    }
+}
@@ -14,36 +14,40 @@ Skybox::~Skybox() {
     }
 }
 
-void Skybox::generateProceduralSkybox() {
+ImageData Skybox::generateProceduralSkybox() {
     // Generate a simple gradient skybox procedurally
     // Top = light blue, bottom = darker blue (horizon effect)
-    const int width = 512;
-    const int height = 512;
-    std::vector<unsigned char> data(width * height * 3);
-    
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int idx = (y * width + x) * 3;
-            
-            // Gradient from light blue (top) to darker blue (bottom)
-            float t = (float)y / height;
-            float r = 0.4f + 0.2f * (1.0f - t); // Red component
-            float g = 0.6f + 0.2f * (1.0f - t); // Green component
-            float b = 0.9f + 0.1f * (1.0f - t); // Blue component
-            
-            data[idx] = (unsigned char)(r * 255);
-            data[idx + 1] = (unsigned char)(g * 255);
-            data[idx + 2] = (unsigned char)(b * 255);
+    ImageData face;
+    face.width = 512;
+    face.height = 512;
+    face.channels = 3;
+    face.pixels.resize(face.width * face.height * 3);
+    
+    for (int y = 0; y < face.height; y++) {
+        // Gradient from light blue (top) to darker blue (bottom); constant along a row
+        float t = (float)y / face.height;
+        float r = 0.4f + 0.2f * (1.0f - t); // Red component
+        float g = 0.6f + 0.2f * (1.0f - t); // Green component
+        float b = 0.9f + 0.1f * (1.0f - t); // Blue component
+        
+        for (int x = 0; x < face.width; x++) {
+            int idx = (y * face.width + x) * 3;
+            face.pixels[idx] = (unsigned char)(r * 255);
+            face.pixels[idx + 1] = (unsigned char)(g * 255);
+            face.pixels[idx + 2] = (unsigned char)(b * 255);
         }
     }
-    
+    return face;
+}
+
+void Skybox::uploadFaces(const ImageData& face) {
     // Create 6 faces of the cube map (all same for simplicity)
     glGenTextures(1, &m_textureID);
     glBindTexture(GL_TEXTURE_CUBE_MAP, m_textureID);
     
     for (unsigned int i = 0; i < 6; i++) {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, 
-                     width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data.data());
+                     face.width, face.height, 0, GL_RGB, GL_UNSIGNED_BYTE, face.pixels.data());
     }
     
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -55,13 +59,12 @@ void Skybox::generateProceduralSkybox() {
     glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 }
 
-void Skybox::loadSkybox() {
-    // For now, generate procedurally
-    // Later can load from 6 images
-    generateProceduralSkybox();
+void Skybox::init() {
+    if (m_initialized) return;
+    init(generateProceduralSkybox());
 }
 
-void Skybox::init() {
+void Skybox::init(const ImageData& face) {
     if (m_initialized) return;
     
     // Skybox vertices (large cube)
@@ -122,22 +125,17 @@ void Skybox::init() {
     
     glBindVertexArray(0);
     
-    loadSkybox();
+    uploadFaces(face);
     
     m_initialized = true;
 }
 
-void Skybox::render(Shader& shader, const glm::mat4& view, const glm::mat4& projection) {
+void Skybox::render(Shader& shader) {
     if (!m_initialized) init();
     
-    // Remove translation from view matrix (skybox should follow camera rotation only)
-    glm::mat4 skyboxView = glm::mat4(glm::mat3(view));
-    
     glDepthFunc(GL_LEQUAL); // Change depth function so skybox passes depth test at max depth
     
     shader.use();
-    shader.setMat4("view", skyboxView);
-    shader.setMat4("projection", projection);
     
     // Bind skybox texture
     glActiveTexture(GL_TEXTURE0);
@@ -1,5 +1,6 @@
 #pragma once
 #include "Shader.h"
+#include "AssetLoader.h"
 #include <glm/glm.hpp>
 
 class Skybox {
@@ -8,14 +9,19 @@ public:
     ~Skybox();
     
     void init();
-    void render(Shader& shader, const glm::mat4& view, const glm::mat4& projection);
+    // Uses face data prepared ahead of time (e.g. on a loader thread)
+    void init(const ImageData& face);
+    
+    // CPU side of the procedural sky: one face, used for all six. Touches no GL state.
+    static ImageData generateProceduralSkybox();
+    // View/projection come from the FrameData uniform block
+    void render(Shader& shader);
     
 private:
     unsigned int m_VAO, m_VBO;
     unsigned int m_textureID;
     bool m_initialized;
     
-    void loadSkybox();
-    void generateProceduralSkybox();
+    void uploadFaces(const ImageData& face);
 };
 
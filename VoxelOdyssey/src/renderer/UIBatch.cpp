@@ -0,0 +1,188 @@
+#include "UIBatch.h"
+#include "Shader.h"
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+bool UIBatch::s_initialized = false;
+bool UIBatch::s_inPass = false;
+unsigned int UIBatch::s_VAO = 0;
+unsigned int UIBatch::s_VBO = 0;
+unsigned int UIBatch::s_EBO = 0;
+unsigned int UIBatch::s_whiteTexture = 0;
+unsigned int UIBatch::s_currentTexture = 0;
+std::unique_ptr<Shader> UIBatch::s_shader;
+std::vector<UIVertex> UIBatch::s_vertices;
+int UIBatch::s_drawCalls = 0;
+int UIBatch::s_quads = 0;
+int UIBatch::s_lastDrawCalls = 0;
+int UIBatch::s_lastQuads = 0;
+
+void UIBatch::init() {
+    if (s_initialized) return;
+
+    s_shader = std::make_unique<Shader>("assets/shaders/ui.glsl", "assets/shaders/ui_fragment.glsl");
+    s_vertices.reserve(MAX_QUADS * 4);
+
+    // Static index pattern shared by every quad in the batch
+    std::vector<uint16_t> indices(MAX_QUADS * 6);
+    for (int i = 0; i < MAX_QUADS; i++) {
+        uint16_t base = static_cast<uint16_t>(i * 4);
+        indices[i * 6 + 0] = base;
+        indices[i * 6 + 1] = base + 1;
+        indices[i * 6 + 2] = base + 2;
+        indices[i * 6 + 3] = base;
+        indices[i * 6 + 4] = base + 2;
+        indices[i * 6 + 5] = base + 3;
+    }
+
+    glGenVertexArrays(1, &s_VAO);
+    glGenBuffers(1, &s_VBO);
+    glGenBuffers(1, &s_EBO);
+
+    glBindVertexArray(s_VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, s_VBO);
+    glBufferData(GL_ARRAY_BUFFER, MAX_QUADS * 4 * sizeof(UIVertex), nullptr, GL_STREAM_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(UIVertex), (void*)offsetof(UIVertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(UIVertex), (void*)offsetof(UIVertex, texCoord));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(UIVertex), (void*)offsetof(UIVertex, color));
+    glEnableVertexAttribArray(2);
+
+    glBindVertexArray(0);
+
+    // 1x1 white texture so colored quads go through the same program as textured ones
+    unsigned char white[4] = {255, 255, 255, 255};
+    glGenTextures(1, &s_whiteTexture);
+    glBindTexture(GL_TEXTURE_2D, s_whiteTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    s_initialized = true;
+}
+
+void UIBatch::cleanup() {
+    if (!s_initialized) return;
+
+    glDeleteVertexArrays(1, &s_VAO);
+    glDeleteBuffers(1, &s_VBO);
+    glDeleteBuffers(1, &s_EBO);
+    glDeleteTextures(1, &s_whiteTexture);
+    s_shader.reset();
+
+    s_VAO = 0;
+    s_VBO = 0;
+    s_EBO = 0;
+    s_whiteTexture = 0;
+    s_initialized = false;
+}
+
+void UIBatch::begin(int windowWidth, int windowHeight) {
+    if (!s_initialized) init();
+
+    s_vertices.clear();
+    s_currentTexture = s_whiteTexture;
+    s_drawCalls = 0;
+    s_quads = 0;
+    s_inPass = true;
+
+    glm::mat4 projection = glm::ortho(0.0f, (float)windowWidth, (float)windowHeight, 0.0f, -1.0f, 1.0f);
+    s_shader->use();
+    s_shader->setMat4("projection", projection);
+    s_shader->setInt("uiTexture", 0);
+}
+
+void UIBatch::end() {
+    if (!s_inPass) return;
+
+    flush();
+    s_inPass = false;
+    s_lastDrawCalls = s_drawCalls;
+    s_lastQuads = s_quads;
+}
+
+void UIBatch::flush() {
+    if (s_vertices.empty()) return;
+
+    s_shader->use();
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Orphan the previous contents so the driver doesn't stall on in-flight draws
+    glBindBuffer(GL_ARRAY_BUFFER, s_VBO);
+    glBufferData(GL_ARRAY_BUFFER, MAX_QUADS * 4 * sizeof(UIVertex), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, s_vertices.size() * sizeof(UIVertex), s_vertices.data());
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, s_currentTexture);
+
+    glBindVertexArray(s_VAO);
+    glDrawElements(GL_TRIANGLES, (GLsizei)(s_vertices.size() / 4 * 6), GL_UNSIGNED_SHORT, 0);
+    glBindVertexArray(0);
+
+    glDisable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+
+    s_drawCalls++;
+    s_vertices.clear();
+}
+
+void UIBatch::pushQuad(const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3,
+                       const glm::vec2& uvMin, const glm::vec2& uvMax, const glm::vec4& color,
+                       unsigned int texture) {
+    if (!s_inPass) return;
+
+    if (texture != s_currentTexture || s_vertices.size() >= MAX_QUADS * 4) {
+        flush();
+        s_currentTexture = texture;
+    }
+
+    // p0..p3 run clockwise from the top-left corner on screen; textures are
+    // loaded flipped, so the top edge samples uvMax.y
+    s_vertices.push_back({p0, glm::vec2(uvMin.x, uvMax.y), color});
+    s_vertices.push_back({p1, glm::vec2(uvMax.x, uvMax.y), color});
+    s_vertices.push_back({p2, glm::vec2(uvMax.x, uvMin.y), color});
+    s_vertices.push_back({p3, glm::vec2(uvMin.x, uvMin.y), color});
+    s_quads++;
+}
+
+void UIBatch::drawQuad(float x, float y, float width, float height, const glm::vec3& color, float alpha) {
+    pushQuad(glm::vec2(x, y), glm::vec2(x + width, y),
+             glm::vec2(x + width, y + height), glm::vec2(x, y + height),
+             glm::vec2(0.0f), glm::vec2(1.0f), glm::vec4(color, alpha), s_whiteTexture);
+}
+
+void UIBatch::drawTexturedQuad(float x, float y, float width, float height, unsigned int texture,
+                               const glm::vec2& uvMin, const glm::vec2& uvMax, const glm::vec4& tint) {
+    pushQuad(glm::vec2(x, y), glm::vec2(x + width, y),
+             glm::vec2(x + width, y + height), glm::vec2(x, y + height),
+             uvMin, uvMax, tint, texture);
+}
+
+void UIBatch::drawLine(float x0, float y0, float x1, float y1, float thickness, const glm::vec3& color) {
+    // Lines are emitted as thin quads so they batch with everything else
+    // (core profile doesn't guarantee glLineWidth > 1 anyway)
+    glm::vec2 dir(x1 - x0, y1 - y0);
+    float length = std::sqrt(dir.x * dir.x + dir.y * dir.y);
+    if (length <= 0.0f) return;
+
+    glm::vec2 offset = glm::vec2(-dir.y, dir.x) * (thickness * 0.5f / length);
+    glm::vec2 a(x0, y0);
+    glm::vec2 b(x1, y1);
+
+    pushQuad(a + offset, b + offset, b - offset, a - offset,
+             glm::vec2(0.0f), glm::vec2(1.0f), glm::vec4(color, 1.0f), s_whiteTexture);
+}
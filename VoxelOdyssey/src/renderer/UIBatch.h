@@ -0,0 +1,55 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+class Shader;
+
+struct UIVertex {
+    glm::vec2 position;
+    glm::vec2 texCoord;
+    glm::vec4 color;
+};
+
+// Immediate-mode 2D renderer shared by the HUD, inventory and menus.
+// Quads and lines are accumulated into a streaming vertex buffer in screen
+// coordinates (origin top-left) and drawn in as few calls as possible.
+class UIBatch {
+public:
+    static void init();
+    static void cleanup();
+
+    // Start/finish a UI pass; end() flushes whatever is still queued
+    static void begin(int windowWidth, int windowHeight);
+    static void end();
+
+    static void drawQuad(float x, float y, float width, float height, const glm::vec3& color, float alpha = 1.0f);
+    static void drawTexturedQuad(float x, float y, float width, float height, unsigned int texture,
+                                 const glm::vec2& uvMin, const glm::vec2& uvMax,
+                                 const glm::vec4& tint = glm::vec4(1.0f));
+    static void drawLine(float x0, float y0, float x1, float y1, float thickness, const glm::vec3& color);
+
+    // Draw what has been queued so far (called automatically on texture change or overflow)
+    static void flush();
+
+    // Stats for the last completed pass
+    static int getDrawCallCount() { return s_lastDrawCalls; }
+    static int getQuadCount() { return s_lastQuads; }
+
+private:
+    static constexpr int MAX_QUADS = 4096;
+
+    static bool s_initialized;
+    static bool s_inPass;
+    static unsigned int s_VAO, s_VBO, s_EBO;
+    static unsigned int s_whiteTexture;
+    static unsigned int s_currentTexture;
+    static std::unique_ptr<Shader> s_shader;
+    static std::vector<UIVertex> s_vertices;
+    static int s_drawCalls, s_quads;
+    static int s_lastDrawCalls, s_lastQuads;
+
+    static void pushQuad(const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3,
+                         const glm::vec2& uvMin, const glm::vec2& uvMax, const glm::vec4& color,
+                         unsigned int texture);
+};
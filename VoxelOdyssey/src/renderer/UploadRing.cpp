@@ -0,0 +1,99 @@
+#include "UploadRing.h"
+#include "core/Profiler.h"
+#include <glad/glad.h>
+#include <cstring>
+
+// Keeps every staged copy cache-line aligned
+static constexpr size_t UPLOAD_ALIGNMENT = 64;
+
+unsigned int UploadRing::s_buffer = 0;
+GLsync UploadRing::s_fences[FRAMES_IN_FLIGHT] = {};
+int UploadRing::s_segment = 0;
+size_t UploadRing::s_frameUsed = 0;
+bool UploadRing::s_initialized = false;
+
+void UploadRing::init() {
+    if (s_initialized) return;
+    
+    glGenBuffers(1, &s_buffer);
+    glBindBuffer(GL_COPY_READ_BUFFER, s_buffer);
+    glBufferData(GL_COPY_READ_BUFFER, FRAMES_IN_FLIGHT * FRAME_BUDGET_BYTES, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    
+    s_segment = 0;
+    s_frameUsed = 0;
+    s_initialized = true;
+}
+
+void UploadRing::cleanup() {
+    if (!s_initialized) return;
+    
+    for (GLsync& fence : s_fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    glDeleteBuffers(1, &s_buffer);
+    s_buffer = 0;
+    s_initialized = false;
+}
+
+void UploadRing::beginFrame() {
+    if (!s_initialized) return;
+    PROFILE_SCOPE("UploadRing::wait");
+    
+    // The segment was last filled FRAMES_IN_FLIGHT frames ago, so this normally returns
+    // at once; it only blocks when the GPU falls that far behind
+    GLsync& fence = s_fences[s_segment];
+    if (fence) {
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+    s_frameUsed = 0;
+}
+
+void UploadRing::endFrame() {
+    if (!s_initialized) return;
+    
+    if (s_frameUsed > 0) {
+        s_fences[s_segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    s_segment = (s_segment + 1) % FRAMES_IN_FLIGHT;
+}
+
+bool UploadRing::upload(unsigned int dstBuffer, size_t dstOffset, const void* data, size_t bytes) {
+    if (!s_initialized || bytes == 0) return false;
+    
+    size_t offset = (s_frameUsed + UPLOAD_ALIGNMENT - 1) & ~(UPLOAD_ALIGNMENT - 1);
+    if (offset + bytes > FRAME_BUDGET_BYTES) {
+        s_frameUsed = FRAME_BUDGET_BYTES;
+        return false;
+    }
+    size_t ringOffset = s_segment * FRAME_BUDGET_BYTES + offset;
+    
+    // The fence already guarantees the GPU is done with this range, so the driver
+    // doesn't need to synchronize the mapping
+    glBindBuffer(GL_COPY_READ_BUFFER, s_buffer);
+    void* staging = glMapBufferRange(GL_COPY_READ_BUFFER, ringOffset, bytes,
+                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!staging) return false;
+    std::memcpy(staging, data, bytes);
+    if (glUnmapBuffer(GL_COPY_READ_BUFFER) == GL_FALSE) {
+        // Contents were lost (e.g. a mode switch); let the caller upload directly
+        return false;
+    }
+    
+    glBindBuffer(GL_COPY_WRITE_BUFFER, dstBuffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, ringOffset, dstOffset, bytes);
+    
+    s_frameUsed = offset + bytes;
+    Profiler::increment(ProfileCounter::UPLOAD_BYTES, static_cast<int64_t>(bytes));
+    return true;
+}
+
+bool UploadRing::hasFrameBudget() {
+    return !s_initialized || s_frameUsed < FRAME_BUDGET_BYTES;
+}
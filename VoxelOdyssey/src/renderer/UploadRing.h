@@ -0,0 +1,39 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstddef>
+
+// Staging buffer for chunk mesh uploads.
+// One large GL buffer split into a segment per frame in flight. Mesh data is memcpy'd
+// into the current frame's segment and then copied GPU-side (glCopyBufferSubData) into
+// the destination buffer, so uploads never wait on draws still reading the old data.
+// A fence per segment keeps the CPU from overwriting a segment the GPU hasn't consumed.
+// The segment size is also the per-frame upload budget: once it is used up, upload()
+// refuses and callers either fall back to a direct upload or wait for the next frame.
+class UploadRing {
+public:
+    static constexpr int FRAMES_IN_FLIGHT = 3;
+    static constexpr size_t FRAME_BUDGET_BYTES = 4 * 1024 * 1024;
+    
+    static void init();
+    static void cleanup();
+    
+    // Start of frame: waits (rarely) for the segment about to be reused
+    static void beginFrame();
+    // After the frame's last upload: fences the segment
+    static void endFrame();
+    
+    // Stage data and copy it into dstBuffer at dstOffset. Returns false when the ring
+    // isn't initialized or this frame's budget doesn't have room for it; after that the
+    // budget counts as spent for the rest of the frame.
+    static bool upload(unsigned int dstBuffer, size_t dstOffset, const void* data, size_t bytes);
+    
+    // False once this frame's budget is used up (always true without a ring)
+    static bool hasFrameBudget();
+    
+private:
+    static unsigned int s_buffer;
+    static GLsync s_fences[FRAMES_IN_FLIGHT];
+    static int s_segment;
+    static size_t s_frameUsed;
+    static bool s_initialized;
+};
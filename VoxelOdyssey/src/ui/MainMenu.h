@@ -1,5 +1,4 @@
 #pragma once
-#include "renderer/Shader.h"
 #include <glm/glm.hpp>
 #include <string>
 
@@ -14,10 +13,9 @@ enum class MainMenuState {
 
 class MainMenu {
 public:
-    static void init();
-    static void cleanup();
+    static constexpr int VISIBLE_WORLDS = 5;  // Rows on the world selection screen
     
-    static void render(Shader& shader, int windowWidth, int windowHeight);
+    static void render(int windowWidth, int windowHeight);
     static void update(float deltaTime);
     
     static bool isOpen() { return s_isOpen; }
@@ -37,21 +35,16 @@ public:
     static void setCreatingWorld(bool creating) { s_creatingWorld = creating; }
     
 private:
-    static bool s_initialized;
     static bool s_isOpen;
     static MainMenuState s_state;
     static int s_selectedWorldIndex;
     static std::string s_newWorldName;
     static bool s_creatingWorld;
-    static unsigned int s_quadVAO, s_quadVBO;
     
-    static void setupQuadVAO();
-    static void renderMainScreen(Shader& shader, int windowWidth, int windowHeight);
-    static void renderSingleplayerScreen(Shader& shader, int windowWidth, int windowHeight);
-    static void renderNewWorldScreen(Shader& shader, int windowWidth, int windowHeight);
-    static void renderSelectWorldScreen(Shader& shader, int windowWidth, int windowHeight);
-    static void renderButton(Shader& shader, float x, float y, float width, float height,
-                            const glm::vec3& color, const glm::mat4& projection);
+    static void renderMainScreen(int windowWidth, int windowHeight);
+    static void renderSingleplayerScreen(int windowWidth, int windowHeight);
+    static void renderNewWorldScreen(int windowWidth, int windowHeight);
+    static void renderSelectWorldScreen(int windowWidth, int windowHeight);
     static bool isMouseOverButton(float mouseX, float mouseY, float btnX, float btnY,
                                  float btnWidth, float btnHeight, int windowWidth, int windowHeight);
 };
@@ -0,0 +1,163 @@
+#include "BiomeMap.h"
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// Samples per region side; the far edge is shared with the next region's near edge
+static constexpr int REGION_SAMPLES = BiomeMap::REGION_CELLS + 1;
+
+struct ClimateRegion {
+    Climate samples[REGION_SAMPLES * REGION_SAMPLES];  // Indexed x * REGION_SAMPLES + z
+};
+
+struct CachedRegion {
+    std::shared_ptr<const ClimateRegion> region;
+    std::list<int64_t>::iterator recency;
+};
+
+static std::mutex s_mutex;
+static std::unordered_map<int64_t, CachedRegion> s_regions;
+static std::list<int64_t> s_recency;    // Most recently used first
+static size_t s_maxRegions = BiomeMap::DEFAULT_MAX_REGIONS;
+static BiomeMapStats s_stats;
+
+// Last region each thread looked at. Consecutive columns nearly always share a region,
+// so most lookups never take the lock. The reference keeps the region alive if the
+// cache drops it in the meantime; the plain pointer is what lookups check, since it is
+// cheaper to reach than a thread_local with a destructor.
+static thread_local int64_t t_lastKey = 0;
+static thread_local const ClimateRegion* t_lastRegion = nullptr;
+static thread_local std::shared_ptr<const ClimateRegion> t_lastRegionRef;
+
+// Rounds toward negative infinity, so negative coordinates map to the right region
+static int floorDiv(int value, int divisor) {
+    return value < 0 ? (value - divisor + 1) / divisor : value / divisor;
+}
+
+static int64_t getRegionKey(int regionX, int regionZ) {
+    return (static_cast<int64_t>(regionX) << 32) | static_cast<uint32_t>(regionZ);
+}
+
+// Biome noise for determining biome type
+static float biomeNoise(float x, float z) {
+    return std::sin(x * 0.05f) * std::cos(z * 0.05f) +
+           0.5f * std::sin(x * 0.1f) * std::cos(z * 0.1f);
+}
+
+static std::shared_ptr<const ClimateRegion> buildRegion(int regionX, int regionZ) {
+    auto region = std::make_shared<ClimateRegion>();
+    for (int x = 0; x < REGION_SAMPLES; x++) {
+        for (int z = 0; z < REGION_SAMPLES; z++) {
+            float worldX = static_cast<float>(regionX * BiomeMap::REGION_SIZE + x * BiomeMap::CELL_SIZE);
+            float worldZ = static_cast<float>(regionZ * BiomeMap::REGION_SIZE + z * BiomeMap::CELL_SIZE);
+            Climate& climate = region->samples[x * REGION_SAMPLES + z];
+            climate.biomeValue = biomeNoise(worldX, worldZ);
+            climate.distance = std::sqrt(worldX * worldX + worldZ * worldZ);
+        }
+    }
+    return region;
+}
+
+// Caller holds s_mutex
+static void evictRegions() {
+    while (s_regions.size() > s_maxRegions) {
+        s_regions.erase(s_recency.back());
+        s_recency.pop_back();
+        s_stats.evictions++;
+    }
+}
+
+static const ClimateRegion& getRegion(int regionX, int regionZ) {
+    int64_t key = getRegionKey(regionX, regionZ);
+    if (t_lastRegion && t_lastKey == key) {
+        return *t_lastRegion;
+    }
+
+    std::shared_ptr<const ClimateRegion> region;
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        auto it = s_regions.find(key);
+        if (it != s_regions.end()) {
+            s_recency.splice(s_recency.begin(), s_recency, it->second.recency);
+            s_stats.hits++;
+            region = it->second.region;
+        }
+    }
+
+    if (!region) {
+        // Sampled outside the lock; if another thread got there first its copy is kept
+        std::shared_ptr<const ClimateRegion> built = buildRegion(regionX, regionZ);
+        std::lock_guard<std::mutex> lock(s_mutex);
+        auto it = s_regions.find(key);
+        if (it != s_regions.end()) {
+            region = it->second.region;
+        } else {
+            s_recency.push_front(key);
+            s_regions[key] = CachedRegion{built, s_recency.begin()};
+            s_stats.misses++;
+            evictRegions();
+            region = std::move(built);
+        }
+    }
+
+    t_lastKey = key;
+    t_lastRegion = region.get();
+    t_lastRegionRef = std::move(region);
+    return *t_lastRegion;
+}
+
+Climate BiomeMap::getClimate(int worldX, int worldZ) {
+    int regionX = floorDiv(worldX, REGION_SIZE);
+    int regionZ = floorDiv(worldZ, REGION_SIZE);
+    const ClimateRegion& region = getRegion(regionX, regionZ);
+
+    int localX = worldX - regionX * REGION_SIZE;
+    int localZ = worldZ - regionZ * REGION_SIZE;
+    int cellX = localX / CELL_SIZE;
+    int cellZ = localZ / CELL_SIZE;
+    float fx = static_cast<float>(localX % CELL_SIZE) / CELL_SIZE;
+    float fz = static_cast<float>(localZ % CELL_SIZE) / CELL_SIZE;
+
+    // Bilinear blend of the samples at the cell's corners
+    const Climate& c00 = region.samples[cellX * REGION_SAMPLES + cellZ];
+    const Climate& c01 = region.samples[cellX * REGION_SAMPLES + cellZ + 1];
+    const Climate& c10 = region.samples[(cellX + 1) * REGION_SAMPLES + cellZ];
+    const Climate& c11 = region.samples[(cellX + 1) * REGION_SAMPLES + cellZ + 1];
+    auto blend = [fx, fz](float v00, float v01, float v10, float v11) {
+        float lowX = v00 + (v01 - v00) * fz;
+        float highX = v10 + (v11 - v10) * fz;
+        return lowX + (highX - lowX) * fx;
+    };
+
+    Climate climate;
+    climate.biomeValue = blend(c00.biomeValue, c01.biomeValue, c10.biomeValue, c11.biomeValue);
+    climate.distance = blend(c00.distance, c01.distance, c10.distance, c11.distance);
+    return climate;
+}
+
+void BiomeMap::setMaxRegions(size_t count) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_maxRegions = count;
+    evictRegions();
+}
+
+size_t BiomeMap::getMaxRegions() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_maxRegions;
+}
+
+void BiomeMap::clear() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_regions.clear();
+    s_recency.clear();
+}
+
+BiomeMapStats BiomeMap::getStats() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    BiomeMapStats stats = s_stats;
+    stats.regions = s_regions.size();
+    return stats;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+
+enum class Biome {
+    GRASSLAND,
+    DESERT,
+    SNOW,
+    FOREST,
+    OCEAN
+};
+
+// Large-scale inputs to biome selection at one column. Both change over hundreds of
+// blocks, so they are sampled coarsely and blended rather than evaluated per column.
+struct Climate {
+    float biomeValue;   // Biome noise, roughly -1.5 to 1.5
+    float distance;     // Horizontal distance from the world origin
+};
+
+struct BiomeMapStats {
+    size_t regions = 0;     // Currently cached
+    size_t hits = 0;        // Region lookups found cached (a thread's last region skips the lookup)
+    size_t misses = 0;      // Regions sampled
+    size_t evictions = 0;
+};
+
+// Climate sampled every CELL_SIZE columns, a region of REGION_CELLS x REGION_CELLS
+// cells at a time, with the least recently used regions dropped past a cap. Columns
+// blend the four samples around them, so the result only depends on position and
+// stays the same whichever regions happen to be cached. Safe to call from any thread.
+class BiomeMap {
+public:
+    static constexpr int CELL_SIZE = 4;
+    static constexpr int REGION_CELLS = 32;
+    static constexpr int REGION_SIZE = CELL_SIZE * REGION_CELLS;    // Columns per region side
+    static constexpr size_t DEFAULT_MAX_REGIONS = 256;
+
+    static Climate getClimate(int worldX, int worldZ);
+
+    static void setMaxRegions(size_t count);
+    static size_t getMaxRegions();
+    static void clear();
+    static BiomeMapStats getStats();
+};
@@ -1,5 +1,7 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
 
 enum class BlockType : uint8_t {
     AIR = 0,
@@ -18,53 +20,118 @@ enum class BlockType : uint8_t {
 
 struct Block {
     BlockType type = BlockType::AIR;
-    //Later: Light level, etc.
+    // Light lives in a separate per-chunk nibble array (Chunk::getLight)
 
 };
 
+// Face: 0=front, 1=back, 2=top, 3=bottom, 4=right, 5=left
+constexpr int BLOCK_FACE_COUNT = 6;
+
+// Static per-type properties. Adding a block only needs a new enum entry
+// and (if it differs from the defaults) an entry in makeBlockProperties().
+struct BlockProperties {
+    bool opaque;            // Hides the faces of neighbours and darkens AO
+    bool solid;             // Can be targeted by raycasts / collided with
+    uint8_t faceTexture[BLOCK_FACE_COUNT]; // Atlas cell per face
+    uint8_t lightEmission;  // 0-15
+    float hardness;         // Seconds to break by hand (unused for now)
+    uint32_t mapColor;      // 0xRRGGBB average colour, used where textures aren't (far terrain LOD)
+};
+
+constexpr int BLOCK_TYPE_COUNT = static_cast<int>(BlockType::COUNT);
+
+namespace detail {
+    constexpr void setAllFaces(BlockProperties& props, uint8_t cell) {
+        for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+            props.faceTexture[face] = cell;
+        }
+    }
+
+    constexpr std::array<BlockProperties, BLOCK_TYPE_COUNT> makeBlockProperties() {
+        std::array<BlockProperties, BLOCK_TYPE_COUNT> table{};
+
+        // Defaults: opaque solid cube using its own atlas cell on every face
+        for (int i = 0; i < BLOCK_TYPE_COUNT; i++) {
+            table[i].opaque = true;
+            table[i].solid = true;
+            setAllFaces(table[i], static_cast<uint8_t>(i));
+            table[i].lightEmission = 0;
+            table[i].hardness = 1.0f;
+            table[i].mapColor = 0x808080;
+        }
+
+        BlockProperties& air = table[static_cast<int>(BlockType::AIR)];
+        air.opaque = false;
+        air.solid = false;
+        air.hardness = 0.0f;
+
+        // Grass: top uses grass, sides use grass side, bottom uses dirt
+        BlockProperties& grass = table[static_cast<int>(BlockType::GRASS)];
+        setAllFaces(grass, static_cast<uint8_t>(BlockType::GRASS) + 1);
+        grass.faceTexture[2] = static_cast<uint8_t>(BlockType::GRASS);
+        grass.faceTexture[3] = static_cast<uint8_t>(BlockType::DIRT);
+        grass.hardness = 0.6f;
+
+        // Wood: top/bottom use wood rings, sides use wood bark
+        BlockProperties& wood = table[static_cast<int>(BlockType::WOOD)];
+        setAllFaces(wood, static_cast<uint8_t>(BlockType::WOOD) + 1);
+        wood.faceTexture[2] = static_cast<uint8_t>(BlockType::WOOD);
+        wood.faceTexture[3] = static_cast<uint8_t>(BlockType::WOOD);
+        wood.hardness = 2.0f;
+
+        // Leaves let light and sight through
+        BlockProperties& leaves = table[static_cast<int>(BlockType::LEAVES)];
+        leaves.opaque = false;
+        leaves.hardness = 0.2f;
+
+        grass.mapColor = 0x5B8C3A;
+        wood.mapColor = 0x6B4A2B;
+        leaves.mapColor = 0x2F6B2A;
+        table[static_cast<int>(BlockType::DIRT)].mapColor = 0x8B5E3C;
+        table[static_cast<int>(BlockType::STONE)].mapColor = 0x7F7F7F;
+        table[static_cast<int>(BlockType::SAND)].mapColor = 0xDBCB96;
+        table[static_cast<int>(BlockType::GRAVEL)].mapColor = 0x6E6A66;
+        table[static_cast<int>(BlockType::SNOW)].mapColor = 0xF0F4F8;
+        table[static_cast<int>(BlockType::COAL_ORE)].mapColor = 0x5A5A5A;
+        table[static_cast<int>(BlockType::IRON_ORE)].mapColor = 0x9C8A7A;
+        
+        table[static_cast<int>(BlockType::DIRT)].hardness = 0.5f;
+        table[static_cast<int>(BlockType::SAND)].hardness = 0.5f;
+        table[static_cast<int>(BlockType::GRAVEL)].hardness = 0.6f;
+        table[static_cast<int>(BlockType::SNOW)].hardness = 0.2f;
+        table[static_cast<int>(BlockType::STONE)].hardness = 1.5f;
+        table[static_cast<int>(BlockType::COAL_ORE)].hardness = 3.0f;
+        table[static_cast<int>(BlockType::IRON_ORE)].hardness = 3.0f;
+
+        return table;
+    }
+}
+
+inline constexpr std::array<BlockProperties, BLOCK_TYPE_COUNT> BLOCK_PROPERTIES = detail::makeBlockProperties();
+
+static_assert(!BLOCK_PROPERTIES[0].opaque && !BLOCK_PROPERTIES[0].solid, "AIR must be empty");
+
+constexpr const BlockProperties& getBlockProperties(BlockType type) {
+    return BLOCK_PROPERTIES[static_cast<int>(type)];
+}
+
+constexpr bool isOpaque(BlockType type) { return getBlockProperties(type).opaque; }
+constexpr bool isSolid(BlockType type) { return getBlockProperties(type).solid; }
+
+inline glm::vec3 getMapColor(BlockType type) {
+    uint32_t rgb = getBlockProperties(type).mapColor;
+    return glm::vec3((rgb >> 16) & 0xFF, (rgb >> 8) & 0xFF, rgb & 0xFF) / 255.0f;
+}
+
+// A face is hidden by opaque neighbours, and by neighbours of the same
+// transparent type (so leaf clusters don't render their interior)
+constexpr bool isFaceVisible(BlockType type, BlockType neighbor) {
+    return !isOpaque(neighbor) && neighbor != type;
+}
+
 //Tex coords for atlas (uvs per face; atlas is 4x4 for 16 types)
 inline glm::vec2 getTexCoord(BlockType type, int face) {
-    // Texture atlas: 4x4 grid, each block type gets one cell
-    // Face: 0=front, 1=back, 2=top, 3=bottom, 4=right, 5=left
-    
     float texSize = 0.25f; // Size of one texture in atlas
-    
-    // Get base texture coordinates for this block type
-    int typeIndex = (int)type;
-    float baseX = (typeIndex % 4) * texSize;
-    float baseY = (typeIndex / 4) * texSize;
-    
-    // Different blocks have different face textures
-    switch (type) {
-        case BlockType::GRASS:
-            // Grass: top uses grass, sides use grass side, bottom uses dirt
-            if (face == 2) { // Top
-                return {baseX, baseY};
-            } else if (face == 3) { // Bottom
-                int dirtIndex = (int)BlockType::DIRT;
-                return {(dirtIndex % 4) * texSize, (dirtIndex / 4) * texSize};
-            } else { // Sides - use grass side texture (assume it's next to grass)
-                return {baseX + texSize, baseY}; // Offset for side texture
-            }
-            
-        case BlockType::WOOD:
-            // Wood: top/bottom use wood rings, sides use wood bark
-            if (face == 2 || face == 3) { // Top/Bottom
-                return {baseX, baseY};
-            } else { // Sides
-                return {baseX + texSize, baseY}; // Side texture
-            }
-            
-        case BlockType::LEAVES:
-        case BlockType::SAND:
-        case BlockType::GRAVEL:
-        case BlockType::DIRT:
-        case BlockType::STONE:
-        case BlockType::SNOW:
-        case BlockType::COAL_ORE:
-        case BlockType::IRON_ORE:
-        default:
-            // All faces use same texture
-            return {baseX, baseY};
-    }
-}
\ No newline at end of file
+    int cell = getBlockProperties(type).faceTexture[face];
+    return {(cell % 4) * texSize, (cell / 4) * texSize};
+}
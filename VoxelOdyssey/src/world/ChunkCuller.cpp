@@ -0,0 +1,177 @@
+#include "ChunkCuller.h"
+#include "core/Frustum.h"
+#include "core/Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define CHUNK_CULL_SSE 1
+#endif
+
+static const glm::vec3 CHUNK_HALF_EXTENTS(CHUNK_SIZE * 0.5f, CHUNK_HEIGHT * 0.5f, CHUNK_SIZE * 0.5f);
+
+// Plane normals split by component. Each plane's distance is pushed out by how far a
+// chunk reaches along its normal, so testing the chunk's center against it is the same
+// as testing the box's positive vertex against the original plane.
+struct CullPlanes {
+    float nx[6], ny[6], nz[6], d[6];
+};
+
+// Rounds toward negative infinity, so negative chunk coordinates map to the right region
+static int floorDiv(int value, int divisor) {
+    return value < 0 ? (value - divisor + 1) / divisor : value / divisor;
+}
+
+static CullPlanes makeCullPlanes(const Frustum& frustum) {
+    CullPlanes planes;
+    for (int i = 0; i < 6; i++) {
+        const glm::vec4& plane = frustum.planes[i];
+        planes.nx[i] = plane.x;
+        planes.ny[i] = plane.y;
+        planes.nz[i] = plane.z;
+        planes.d[i] = plane.w + std::abs(plane.x) * CHUNK_HALF_EXTENTS.x +
+                      std::abs(plane.y) * CHUNK_HALF_EXTENTS.y + std::abs(plane.z) * CHUNK_HALF_EXTENTS.z;
+    }
+    return planes;
+}
+
+static void cullChunks(const CullPlanes& planes, const float* centerX, const float* centerY, const float* centerZ,
+                       Chunk* const* chunks, size_t count, std::vector<Chunk*>& visible) {
+    size_t i = 0;
+#ifdef CHUNK_CULL_SSE
+    __m128 nx[6], ny[6], nz[6], d[6];
+    for (int p = 0; p < 6; p++) {
+        nx[p] = _mm_set1_ps(planes.nx[p]);
+        ny[p] = _mm_set1_ps(planes.ny[p]);
+        nz[p] = _mm_set1_ps(planes.nz[p]);
+        d[p] = _mm_set1_ps(planes.d[p]);
+    }
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(centerX + i);
+        __m128 y = _mm_loadu_ps(centerY + i);
+        __m128 z = _mm_loadu_ps(centerZ + i);
+
+        __m128 outside = zero;
+        for (int p = 0; p < 6; p++) {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, nx[p]), _mm_mul_ps(y, ny[p])),
+                                         _mm_add_ps(_mm_mul_ps(z, nz[p]), d[p]));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+        }
+
+        int visibleMask = ~_mm_movemask_ps(outside) & 0xF;
+        for (int lane = 0; visibleMask != 0; lane++, visibleMask >>= 1) {
+            if (visibleMask & 1) {
+                visible.push_back(chunks[i + lane]);
+            }
+        }
+    }
+#endif
+
+    // Remainder (and everything, without SSE)
+    for (; i < count; i++) {
+        bool inside = true;
+        for (int p = 0; p < 6 && inside; p++) {
+            float distance = (centerX[i] * planes.nx[p] + centerY[i] * planes.ny[p]) +
+                             (centerZ[i] * planes.nz[p] + planes.d[p]);
+            inside = distance >= 0.0f;
+        }
+        if (inside) {
+            visible.push_back(chunks[i]);
+        }
+    }
+}
+
+glm::ivec2 ChunkCuller::getRegionKey(const glm::ivec3& chunkPos) {
+    return glm::ivec2(floorDiv(chunkPos.x, REGION_SIZE), floorDiv(chunkPos.z, REGION_SIZE));
+}
+
+uint64_t ChunkCuller::packRegionKey(const glm::ivec2& key) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(key.x)) << 32) | static_cast<uint32_t>(key.y);
+}
+
+void ChunkCuller::add(Chunk* chunk) {
+    glm::ivec3 chunkPos = chunk->getPosition();
+    glm::ivec2 key = getRegionKey(chunkPos);
+
+    auto it = m_regionIndex.find(packRegionKey(key));
+    if (it == m_regionIndex.end()) {
+        Region region;
+        region.key = key;
+        region.minChunkY = chunkPos.y;
+        region.maxChunkY = chunkPos.y;
+        m_regions.push_back(std::move(region));
+        it = m_regionIndex.emplace(packRegionKey(key), (int)m_regions.size() - 1).first;
+    }
+
+    Region& region = m_regions[it->second];
+    region.minChunkY = std::min(region.minChunkY, chunkPos.y);
+    region.maxChunkY = std::max(region.maxChunkY, chunkPos.y);
+
+    glm::vec3 center = glm::vec3(chunkPos * glm::ivec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE)) + CHUNK_HALF_EXTENTS;
+    chunk->setCullSlot((int)region.chunks.size());
+    region.centerX.push_back(center.x);
+    region.centerY.push_back(center.y);
+    region.centerZ.push_back(center.z);
+    region.chunks.push_back(chunk);
+}
+
+void ChunkCuller::remove(Chunk* chunk) {
+    int slot = chunk->getCullSlot();
+    if (slot < 0) return;
+    chunk->setCullSlot(-1);
+
+    auto it = m_regionIndex.find(packRegionKey(getRegionKey(chunk->getPosition())));
+    if (it == m_regionIndex.end()) return;
+    int regionIndex = it->second;
+    Region& region = m_regions[regionIndex];
+
+    // Swap-remove keeps the arrays dense
+    size_t last = region.chunks.size() - 1;
+    if ((size_t)slot != last) {
+        region.centerX[slot] = region.centerX[last];
+        region.centerY[slot] = region.centerY[last];
+        region.centerZ[slot] = region.centerZ[last];
+        region.chunks[slot] = region.chunks[last];
+        region.chunks[slot]->setCullSlot(slot);
+    }
+    region.centerX.pop_back();
+    region.centerY.pop_back();
+    region.centerZ.pop_back();
+    region.chunks.pop_back();
+
+    if (region.chunks.empty()) {
+        m_regionIndex.erase(it);
+        if ((size_t)regionIndex != m_regions.size() - 1) {
+            m_regions[regionIndex] = std::move(m_regions.back());
+            m_regionIndex[packRegionKey(m_regions[regionIndex].key)] = regionIndex;
+        }
+        m_regions.pop_back();
+    }
+}
+
+void ChunkCuller::cull(const Frustum& frustum, std::vector<Chunk*>& visible) const {
+    PROFILE_SCOPE("ChunkCuller::cull");
+    visible.clear();
+    CullPlanes planes = makeCullPlanes(frustum);
+
+    for (const Region& region : m_regions) {
+        glm::vec3 min(region.key.x * REGION_SIZE * CHUNK_SIZE, region.minChunkY * CHUNK_HEIGHT,
+                      region.key.y * REGION_SIZE * CHUNK_SIZE);
+        glm::vec3 max(min.x + REGION_SIZE * CHUNK_SIZE, (region.maxChunkY + 1) * CHUNK_HEIGHT,
+                      min.z + REGION_SIZE * CHUNK_SIZE);
+
+        FrustumTest test = frustum.classifyAABB(min, max);
+        if (test == FrustumTest::OUTSIDE) {
+            continue;
+        }
+        if (test == FrustumTest::INSIDE) {
+            visible.insert(visible.end(), region.chunks.begin(), region.chunks.end());
+            continue;
+        }
+        cullChunks(planes, region.centerX.data(), region.centerY.data(), region.centerZ.data(),
+                   region.chunks.data(), region.chunks.size(), visible);
+    }
+}
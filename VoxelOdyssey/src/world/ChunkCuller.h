@@ -0,0 +1,39 @@
+#pragma once
+#include "Chunk.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct Frustum;
+
+// Frustum culling for the world's loaded chunks. Chunk centers are kept as a
+// structure of arrays, grouped into regions of REGION_SIZE x REGION_SIZE columns.
+// A region's bounds are tested first. Regions outside the frustum are skipped whole,
+// regions fully inside accept all their chunks, and only regions crossing a plane run
+// the per-chunk kernel, which tests four chunks per iteration with SSE. Every chunk
+// has the same extents, so only the centers need storing.
+class ChunkCuller {
+public:
+    static constexpr int REGION_SIZE = 8;   // Chunk columns along each side of a region
+
+    void add(Chunk* chunk);
+    void remove(Chunk* chunk);
+
+    // Replaces visible with every registered chunk that intersects the frustum
+    void cull(const Frustum& frustum, std::vector<Chunk*>& visible) const;
+
+private:
+    struct Region {
+        glm::ivec2 key;
+        int minChunkY, maxChunkY;   // Only grows while the region has chunks; conservative
+        std::vector<float> centerX, centerY, centerZ;
+        std::vector<Chunk*> chunks;
+    };
+
+    std::vector<Region> m_regions;
+    std::unordered_map<uint64_t, int> m_regionIndex;    // Packed region key -> index in m_regions
+
+    static glm::ivec2 getRegionKey(const glm::ivec3& chunkPos);
+    static uint64_t packRegionKey(const glm::ivec2& key);
+};
@@ -0,0 +1,65 @@
+#include "ChunkPool.h"
+#include <algorithm>
+
+std::vector<Chunk*> ChunkPool::s_freeChunks;
+size_t ChunkPool::s_maxFreeChunks = ChunkPool::DEFAULT_MAX_FREE_CHUNKS;
+ChunkPoolStats ChunkPool::s_stats;
+
+ChunkPool::Handle ChunkPool::acquire(const glm::ivec3& position, bool clearBlocks) {
+    Chunk* chunk;
+    if (!s_freeChunks.empty()) {
+        // Most recently released first; its storage is the likeliest to still be cached
+        chunk = s_freeChunks.back();
+        s_freeChunks.pop_back();
+        chunk->recycle(position);
+        if (clearBlocks) {
+            chunk->clearBlocks();
+        }
+        s_stats.reuses++;
+    } else {
+        // Fresh storage is always initialized to air by the constructor
+        chunk = new Chunk(position);
+        s_stats.heapAllocations++;
+    }
+
+    s_stats.liveChunks++;
+    s_stats.peakLiveChunks = std::max(s_stats.peakLiveChunks, s_stats.liveChunks);
+    return Handle(chunk);
+}
+
+void ChunkPool::release(Chunk* chunk) {
+    if (!chunk) return;
+    s_stats.liveChunks--;
+
+    if (s_freeChunks.size() < s_maxFreeChunks) {
+        s_freeChunks.push_back(chunk);
+    } else {
+        delete chunk;
+        s_stats.heapFrees++;
+    }
+}
+
+void ChunkPool::setMaxFreeChunks(size_t count) {
+    s_maxFreeChunks = count;
+    while (s_freeChunks.size() > s_maxFreeChunks) {
+        delete s_freeChunks.back();
+        s_freeChunks.pop_back();
+        s_stats.heapFrees++;
+    }
+}
+
+void ChunkPool::trim() {
+    for (Chunk* chunk : s_freeChunks) {
+        delete chunk;
+    }
+    s_stats.heapFrees += s_freeChunks.size();
+    s_freeChunks.clear();
+    s_freeChunks.shrink_to_fit();
+}
+
+ChunkPoolStats ChunkPool::getStats() {
+    ChunkPoolStats stats = s_stats;
+    stats.freeChunks = s_freeChunks.size();
+    stats.bytes = (stats.liveChunks + stats.freeChunks) * sizeof(Chunk);
+    return stats;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Chunk.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+struct ChunkPoolStats {
+    size_t liveChunks = 0;      // Handed out and not yet released
+    size_t freeChunks = 0;      // Kept for reuse
+    size_t peakLiveChunks = 0;
+    size_t heapAllocations = 0; // Chunks ever allocated from the heap
+    size_t heapFrees = 0;       // Released past the cap, or dropped by trim/cleanup
+    size_t reuses = 0;          // Acquires served from the free list
+    size_t bytes = 0;           // Storage held for live and free chunks
+};
+
+// Recycles chunk storage. Released chunks go on a free list (up to a cap) instead of
+// back to the heap, so streaming chunks in and out at a steady render distance stops
+// allocating after the first few seconds and memory stays flat over long sessions.
+// A recycled chunk also keeps its mesh's GL buffers. Main thread only.
+class ChunkPool {
+public:
+    static constexpr size_t DEFAULT_MAX_FREE_CHUNKS = 256;
+
+    struct Deleter {
+        void operator()(Chunk* chunk) const { ChunkPool::release(chunk); }
+    };
+    using Handle = std::unique_ptr<Chunk, Deleter>;
+
+    // A recycled chunk comes back with its light, mesh, links and flags reset, but its
+    // blocks left as the previous owner had them. Pass clearBlocks unless every block is
+    // about to be written anyway (generation, deserialize).
+    static Handle acquire(const glm::ivec3& position, bool clearBlocks);
+    static void release(Chunk* chunk);
+
+    // Free chunks kept beyond this are returned to the heap
+    static void setMaxFreeChunks(size_t count);
+    static size_t getMaxFreeChunks() { return s_maxFreeChunks; }
+    // Return every free chunk to the heap
+    static void trim();
+    // Frees the free list's GL buffers too (call before the GL context goes away)
+    static void cleanup() { trim(); }
+
+    static ChunkPoolStats getStats();
+
+private:
+    static std::vector<Chunk*> s_freeChunks;
+    static size_t s_maxFreeChunks;
+    static ChunkPoolStats s_stats;
+};
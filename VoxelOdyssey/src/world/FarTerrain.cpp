@@ -0,0 +1,286 @@
+#include "FarTerrain.h"
+#include "core/Frustum.h"
+#include "core/Profiler.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+static int floorDiv(int value, int divisor) {
+    return value < 0 ? (value - divisor + 1) / divisor : value / divisor;
+}
+
+FarTerrain::Tile::~Tile() {
+    if (VAO != 0) {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &VBO);
+        glDeleteBuffers(1, &EBO);
+    }
+}
+
+FarTerrain::FarTerrain()
+    : m_viewDistance(32), m_playerChunk(0, 0), m_nearChunks(0) {
+}
+
+FarTerrain::~FarTerrain() {
+    clear();
+}
+
+void FarTerrain::setViewDistance(int chunks) {
+    m_viewDistance = std::max(0, chunks);
+    if (m_viewDistance == 0) {
+        clear();
+    }
+}
+
+void FarTerrain::clear() {
+    m_tiles.clear();
+}
+
+uint64_t FarTerrain::makeKey(int tileX, int tileZ) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(tileX)) << 32) | static_cast<uint32_t>(tileZ);
+}
+
+int FarTerrain::getStepForDistance(int tileDistance) {
+    if (tileDistance <= 1) return 2;
+    if (tileDistance <= 3) return 4;
+    return 8;
+}
+
+size_t FarTerrain::getGpuMemoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& pair : m_tiles) {
+        bytes += pair.second->vertexBytes + pair.second->indexCount * sizeof(unsigned int);
+    }
+    return bytes;
+}
+
+void FarTerrain::update(const glm::vec3& playerPos, int nearChunks) {
+    m_nearChunks = nearChunks;
+    m_playerChunk = glm::ivec2(floorDiv(static_cast<int>(std::floor(playerPos.x)), CHUNK_SIZE),
+                               floorDiv(static_cast<int>(std::floor(playerPos.z)), CHUNK_SIZE));
+    if (m_viewDistance <= nearChunks) {
+        clear();
+        return;
+    }
+
+    PROFILE_SCOPE("FarTerrain::update");
+
+    glm::ivec2 playerTile(floorDiv(m_playerChunk.x, TILE_CHUNKS), floorDiv(m_playerChunk.y, TILE_CHUNKS));
+    int tileRadius = (m_viewDistance + TILE_CHUNKS - 1) / TILE_CHUNKS;
+
+    // Block-space rectangle already covered by full-detail chunks
+    int nearMinX = (m_playerChunk.x - nearChunks) * CHUNK_SIZE;
+    int nearMinZ = (m_playerChunk.y - nearChunks) * CHUNK_SIZE;
+    int nearMaxX = (m_playerChunk.x + nearChunks + 1) * CHUNK_SIZE;
+    int nearMaxZ = (m_playerChunk.y + nearChunks + 1) * CHUNK_SIZE;
+
+    // Drop tiles that left the ring
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        int tileX = static_cast<int32_t>(it->first >> 32);
+        int tileZ = static_cast<int32_t>(it->first & 0xFFFFFFFFu);
+        int distance = std::max(std::abs(tileX - playerTile.x), std::abs(tileZ - playerTile.y));
+        if (distance > tileRadius + 1) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Collect tiles that are missing or at the wrong step, nearest first
+    struct PendingTile { int x, z, step, distance; };
+    std::vector<PendingTile> pending;
+    for (int dz = -tileRadius; dz <= tileRadius; dz++) {
+        for (int dx = -tileRadius; dx <= tileRadius; dx++) {
+            int tileX = playerTile.x + dx;
+            int tileZ = playerTile.y + dz;
+            int minX = tileX * TILE_SIZE;
+            int minZ = tileZ * TILE_SIZE;
+
+            // Entirely under full-detail chunks: nothing would survive the clip
+            if (minX >= nearMinX && minX + TILE_SIZE <= nearMaxX &&
+                minZ >= nearMinZ && minZ + TILE_SIZE <= nearMaxZ) {
+                continue;
+            }
+
+            int distance = std::max(std::abs(dx), std::abs(dz));
+            int step = getStepForDistance(distance);
+            auto it = m_tiles.find(makeKey(tileX, tileZ));
+            if (it == m_tiles.end() || it->second->step != step) {
+                pending.push_back({tileX, tileZ, step, distance});
+            }
+        }
+    }
+
+    std::sort(pending.begin(), pending.end(),
+              [](const PendingTile& a, const PendingTile& b) { return a.distance < b.distance; });
+
+    int builds = std::min(static_cast<int>(pending.size()), MAX_TILE_BUILDS_PER_FRAME);
+    for (int i = 0; i < builds; i++) {
+        buildTile(pending[i].x, pending[i].z, pending[i].step);
+    }
+}
+
+void FarTerrain::buildTile(int tileX, int tileZ, int step) {
+    PROFILE_SCOPE("FarTerrain::buildTile");
+
+    std::vector<FarVertex> vertices;
+    std::vector<unsigned int> indices;
+    auto tile = std::make_unique<Tile>();
+    buildTileMesh(tileX, tileZ, step, vertices, indices, tile->boundsMin, tile->boundsMax);
+    tile->step = step;
+
+    if (!indices.empty()) {
+        glGenVertexArrays(1, &tile->VAO);
+        glGenBuffers(1, &tile->VBO);
+        glGenBuffers(1, &tile->EBO);
+
+        glBindVertexArray(tile->VAO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, tile->VBO);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(FarVertex), vertices.data(), GL_STATIC_DRAW);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tile->EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(FarVertex), (void*)offsetof(FarVertex, position));
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(FarVertex), (void*)offsetof(FarVertex, normal));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(FarVertex), (void*)offsetof(FarVertex, color));
+        glEnableVertexAttribArray(2);
+
+        glBindVertexArray(0);
+
+        tile->indexCount = static_cast<unsigned int>(indices.size());
+        tile->vertexBytes = vertices.size() * sizeof(FarVertex);
+    }
+
+    m_tiles[makeKey(tileX, tileZ)] = std::move(tile);
+}
+
+// Emit a quad, flipping the winding if needed so it faces along the normal
+static void addQuad(std::vector<FarVertex>& vertices, std::vector<unsigned int>& indices,
+                    const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3,
+                    const glm::vec3& normal, const glm::vec3& color) {
+    unsigned int base = static_cast<unsigned int>(vertices.size());
+    vertices.push_back({p0, normal, color});
+    vertices.push_back({p1, normal, color});
+    vertices.push_back({p2, normal, color});
+    vertices.push_back({p3, normal, color});
+
+    bool counterClockwise = glm::dot(glm::cross(p1 - p0, p2 - p0), normal) > 0.0f;
+    if (counterClockwise) {
+        indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    } else {
+        indices.insert(indices.end(), {base, base + 2, base + 1, base, base + 3, base + 2});
+    }
+}
+
+void FarTerrain::buildTileMesh(int tileX, int tileZ, int step,
+                               std::vector<FarVertex>& vertices, std::vector<unsigned int>& indices,
+                               glm::vec3& boundsMin, glm::vec3& boundsMax) {
+    int cells = TILE_SIZE / step;
+    int gridSize = cells + 2;  // One extra cell on each side so edge walls know their neighbours
+    int originX = tileX * TILE_SIZE;
+    int originZ = tileZ * TILE_SIZE;
+
+    // Sample each cell at its centre column
+    std::vector<TerrainColumn> grid(gridSize * gridSize);
+    for (int j = 0; j < gridSize; j++) {
+        for (int i = 0; i < gridSize; i++) {
+            int worldX = originX + (i - 1) * step + step / 2;
+            int worldZ = originZ + (j - 1) * step + step / 2;
+            grid[j * gridSize + i] = World::sampleTerrainColumn(worldX, worldZ);
+        }
+    }
+    auto cellAt = [&](int i, int j) -> const TerrainColumn& { return grid[(j + 1) * gridSize + (i + 1)]; };
+
+    // Skirts hang below tile edges to hide cracks against tiles of a different step
+    float skirtDepth = static_cast<float>(step * 2);
+    const glm::ivec2 directions[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+    boundsMin = glm::vec3(originX, 1e9f, originZ);
+    boundsMax = glm::vec3(originX + TILE_SIZE, -1e9f, originZ + TILE_SIZE);
+
+    vertices.reserve(cells * cells * 8);
+    indices.reserve(cells * cells * 12);
+
+    for (int j = 0; j < cells; j++) {
+        for (int i = 0; i < cells; i++) {
+            const TerrainColumn& column = cellAt(i, j);
+            float top = static_cast<float>(column.groundHeight + 1);  // Top face of the surface block
+            float x0 = static_cast<float>(originX + i * step);
+            float z0 = static_cast<float>(originZ + j * step);
+            float x1 = x0 + step;
+            float z1 = z0 + step;
+
+            addQuad(vertices, indices,
+                    glm::vec3(x0, top, z0), glm::vec3(x0, top, z1), glm::vec3(x1, top, z1), glm::vec3(x1, top, z0),
+                    glm::vec3(0.0f, 1.0f, 0.0f), getMapColor(column.surfaceBlock));
+
+            float lowest = top;
+            glm::vec3 wallColor = getMapColor(column.dirtBlock);
+            for (const glm::ivec2& dir : directions) {
+                int ni = i + dir.x;
+                int nj = j + dir.y;
+                float neighborTop = static_cast<float>(cellAt(ni, nj).groundHeight + 1);
+                bool tileEdge = ni < 0 || nj < 0 || ni >= cells || nj >= cells;
+
+                float bottom = tileEdge ? std::min(top, neighborTop) - skirtDepth : neighborTop;
+                if (bottom >= top) continue;
+                lowest = std::min(lowest, bottom);
+
+                glm::vec3 normal(dir.x, 0.0f, dir.y);
+                if (dir.x != 0) {
+                    float x = dir.x > 0 ? x1 : x0;
+                    addQuad(vertices, indices,
+                            glm::vec3(x, bottom, z0), glm::vec3(x, top, z0), glm::vec3(x, top, z1), glm::vec3(x, bottom, z1),
+                            normal, wallColor);
+                } else {
+                    float z = dir.y > 0 ? z1 : z0;
+                    addQuad(vertices, indices,
+                            glm::vec3(x0, bottom, z), glm::vec3(x0, top, z), glm::vec3(x1, top, z), glm::vec3(x1, bottom, z),
+                            normal, wallColor);
+                }
+            }
+
+            boundsMin.y = std::min(boundsMin.y, lowest);
+            boundsMax.y = std::max(boundsMax.y, top);
+        }
+    }
+}
+
+void FarTerrain::resolveUniforms(const Shader& shader) {
+    m_nearClipUniform = shader.getUniform<glm::vec4>("nearClip");
+    m_fogRangeUniform = shader.getUniform<glm::vec2>("fogRange");
+}
+
+void FarTerrain::render(Shader& shader, const Frustum& frustum) const {
+    if (m_tiles.empty()) return;
+
+    PROFILE_SCOPE("FarTerrain::render");
+
+    shader.use();
+
+    // Fragments inside the full-detail area are discarded; fade into the sky at the far edge
+    glm::vec4 nearClip((m_playerChunk.x - m_nearChunks) * CHUNK_SIZE,
+                       (m_playerChunk.y - m_nearChunks) * CHUNK_SIZE,
+                       (m_playerChunk.x + m_nearChunks + 1) * CHUNK_SIZE,
+                       (m_playerChunk.y + m_nearChunks + 1) * CHUNK_SIZE);
+    shader.set(m_nearClipUniform, nearClip);
+    float fogEnd = static_cast<float>(m_viewDistance * CHUNK_SIZE);
+    shader.set(m_fogRangeUniform, glm::vec2(fogEnd * 0.6f, fogEnd));
+
+    for (const auto& pair : m_tiles) {
+        const Tile& tile = *pair.second;
+        if (tile.indexCount == 0 || !frustum.isAABBInside(tile.boundsMin, tile.boundsMax)) {
+            continue;
+        }
+
+        glBindVertexArray(tile.VAO);
+        glDrawElements(GL_TRIANGLES, tile.indexCount, GL_UNSIGNED_INT, 0);
+        Profiler::increment(ProfileCounter::TRIANGLES, tile.indexCount / 3);
+    }
+    glBindVertexArray(0);
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "World.h"
+#include "renderer/Shader.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+struct Frustum;
+
+struct FarVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec3 color;
+};
+
+// Heightmap-only terrain drawn beyond the block render distance.
+// The ring is split into square tiles of TILE_CHUNKS x TILE_CHUNKS chunks. Each tile
+// is meshed straight from World::sampleTerrainColumn as blocky cells of 2, 4 or 8
+// blocks depending on distance, so no Chunk or block array is ever allocated for it.
+// Tile edges get skirts so neighbouring tiles at different steps don't show cracks,
+// and the area covered by full-detail chunks is clipped away in the fragment shader.
+class FarTerrain {
+public:
+    static constexpr int TILE_CHUNKS = 4;
+    static constexpr int TILE_SIZE = TILE_CHUNKS * CHUNK_SIZE;  // Blocks per tile side
+    static constexpr int MAX_TILE_BUILDS_PER_FRAME = 2;
+
+    FarTerrain();
+    ~FarTerrain();
+
+    FarTerrain(const FarTerrain&) = delete;
+    FarTerrain& operator=(const FarTerrain&) = delete;
+
+    // View distance in chunks; 0 disables far terrain
+    void setViewDistance(int chunks);
+    int getViewDistance() const { return m_viewDistance; }
+
+    // Looks up the uniforms render sets; call again whenever the shader is rebuilt
+    void resolveUniforms(const Shader& shader);
+
+    // nearChunks is the radius covered by full-detail chunks around the player
+    void update(const glm::vec3& playerPos, int nearChunks);
+    void render(Shader& shader, const Frustum& frustum) const;
+    void clear();
+
+    size_t getTileCount() const { return m_tiles.size(); }
+    size_t getGpuMemoryBytes() const;
+
+    // Cell size in blocks for a tile at the given Chebyshev distance (in tiles) from the player
+    static int getStepForDistance(int tileDistance);
+
+    // CPU side of a tile mesh; exposed so it can be built off the render thread later
+    static void buildTileMesh(int tileX, int tileZ, int step,
+                              std::vector<FarVertex>& vertices, std::vector<unsigned int>& indices,
+                              glm::vec3& boundsMin, glm::vec3& boundsMax);
+
+private:
+    struct Tile {
+        int step = 0;
+        unsigned int VAO = 0, VBO = 0, EBO = 0;
+        unsigned int indexCount = 0;
+        size_t vertexBytes = 0;
+        glm::vec3 boundsMin = glm::vec3(0.0f);
+        glm::vec3 boundsMax = glm::vec3(0.0f);
+
+        ~Tile();
+    };
+
+    std::unordered_map<uint64_t, std::unique_ptr<Tile>> m_tiles;
+    int m_viewDistance;
+    glm::ivec2 m_playerChunk;
+    int m_nearChunks;
+    Uniform<glm::vec4> m_nearClipUniform;
+    Uniform<glm::vec2> m_fogRangeUniform;
+
+    static uint64_t makeKey(int tileX, int tileZ);
+    void buildTile(int tileX, int tileZ, int step);
+};
@@ -0,0 +1,255 @@
+#include "LightEngine.h"
+#include "World.h"
+#include "core/Profiler.h"
+
+static const glm::ivec3 DIRECTIONS[6] = {
+    {0, 0, 1}, {0, 0, -1}, {0, 1, 0}, {0, -1, 0}, {1, 0, 0}, {-1, 0, 0}
+};
+
+// Rounds toward negative infinity, so negative block coordinates map to the right chunk
+static int floorDiv(int value, int divisor) {
+    return value < 0 ? (value - divisor + 1) / divisor : value / divisor;
+}
+
+static int getChannel(uint8_t light, LightChannel channel) {
+    return channel == LightChannel::SKY ? getSkyLight(light) : getBlockLight(light);
+}
+
+static uint8_t withChannel(uint8_t light, LightChannel channel, int level) {
+    return channel == LightChannel::SKY ? packLight(level, getBlockLight(light))
+                                        : packLight(getSkyLight(light), level);
+}
+
+// Sky light at full strength keeps going straight down; everything else loses a level per block
+static int spreadLevel(LightChannel channel, int level, const glm::ivec3& dir) {
+    if (channel == LightChannel::SKY && dir.y == -1 && level == MAX_LIGHT) {
+        return MAX_LIGHT;
+    }
+    return level - 1;
+}
+
+LightEngine::LightEngine(World& world)
+    : m_world(world), m_cachedChunk(nullptr), m_cachedChunkPos(0), m_cacheValid(false) {
+}
+
+void LightEngine::invalidateCache() {
+    // Chunks may have been loaded or unloaded since the last call
+    m_cachedChunk = nullptr;
+    m_cacheValid = false;
+}
+
+Chunk* LightEngine::findChunk(int worldX, int worldY, int worldZ) {
+    glm::ivec3 chunkPos(floorDiv(worldX, CHUNK_SIZE), floorDiv(worldY, CHUNK_HEIGHT), floorDiv(worldZ, CHUNK_SIZE));
+    if (!m_cacheValid || chunkPos != m_cachedChunkPos) {
+        // Propagation steps one block at a time, so the next chunk is nearly always a
+        // linked neighbour of the last one
+        int face = m_cacheValid && m_cachedChunk ? getNeighborFace(chunkPos - m_cachedChunkPos) : -1;
+        if (face >= 0 && m_cachedChunk->isNeighborReady(face)) {
+            m_cachedChunk = m_cachedChunk->getNeighbor(face);
+        } else {
+            m_cachedChunk = m_world.getChunk(chunkPos.x, chunkPos.y, chunkPos.z);
+        }
+        m_cacheValid = true;
+        m_cachedChunkPos = chunkPos;
+    }
+    return m_cachedChunk;
+}
+
+int LightEngine::getLevel(LightChannel channel, int worldX, int worldY, int worldZ) {
+    Chunk* chunk = findChunk(worldX, worldY, worldZ);
+    if (!chunk) {
+        // Unloaded or all-air chunk; the world knows what light to assume there
+        return getChannel(m_world.getLight(worldX, worldY, worldZ), channel);
+    }
+    glm::ivec3 local = glm::ivec3(worldX, worldY, worldZ) - chunk->getPosition() * glm::ivec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+    return getChannel(chunk->getLight(local.x, local.y, local.z), channel);
+}
+
+void LightEngine::setLevel(LightChannel channel, Chunk& chunk, int worldX, int worldY, int worldZ, int level) {
+    glm::ivec3 local = glm::ivec3(worldX, worldY, worldZ) - chunk.getPosition() * glm::ivec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+    chunk.setLight(local.x, local.y, local.z, withChannel(chunk.getLight(local.x, local.y, local.z), channel, level));
+    m_world.markChunkDirty(chunk);
+
+    // Faces of the neighbouring chunk sample light from border blocks
+    if (local.x == 0 || local.x == CHUNK_SIZE - 1 || local.y == 0 || local.y == CHUNK_HEIGHT - 1 ||
+        local.z == 0 || local.z == CHUNK_SIZE - 1) {
+        m_world.markChunkDirty(worldX, worldY, worldZ);
+    }
+}
+
+bool LightEngine::isOpaqueAt(Chunk& chunk, int worldX, int worldY, int worldZ) const {
+    glm::ivec3 local = glm::ivec3(worldX, worldY, worldZ) - chunk.getPosition() * glm::ivec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+    return isOpaque(chunk.getBlockType(local.x, local.y, local.z));
+}
+
+void LightEngine::queueNeighbours(LightChannel channel, int worldX, int worldY, int worldZ) {
+    for (const glm::ivec3& dir : DIRECTIONS) {
+        int level = getLevel(channel, worldX + dir.x, worldY + dir.y, worldZ + dir.z);
+        if (level > 0) {
+            m_addQueue.push_back({worldX + dir.x, worldY + dir.y, worldZ + dir.z, level});
+        }
+    }
+}
+
+void LightEngine::propagateAdd(LightChannel channel) {
+    for (size_t i = 0; i < m_addQueue.size(); i++) {
+        LightNode node = m_addQueue[i];
+
+        // Nodes outside stored chunks (open sky, all-air chunks) carry their own level
+        int level = node.level;
+        if (findChunk(node.x, node.y, node.z)) {
+            level = getLevel(channel, node.x, node.y, node.z);
+        }
+        if (level <= 1) continue;
+
+        for (const glm::ivec3& dir : DIRECTIONS) {
+            int x = node.x + dir.x, y = node.y + dir.y, z = node.z + dir.z;
+            Chunk* neighbor = findChunk(x, y, z);
+            if (!neighbor || isOpaqueAt(*neighbor, x, y, z)) continue;
+
+            int newLevel = spreadLevel(channel, level, dir);
+            if (getLevel(channel, x, y, z) >= newLevel) continue;
+
+            setLevel(channel, *neighbor, x, y, z, newLevel);
+            m_addQueue.push_back({x, y, z, newLevel});
+        }
+    }
+    m_addQueue.clear();
+}
+
+void LightEngine::propagateRemove(LightChannel channel) {
+    for (size_t i = 0; i < m_removeQueue.size(); i++) {
+        LightNode node = m_removeQueue[i];
+
+        for (const glm::ivec3& dir : DIRECTIONS) {
+            int x = node.x + dir.x, y = node.y + dir.y, z = node.z + dir.z;
+            int level = getLevel(channel, x, y, z);
+            if (level == 0) continue;
+
+            Chunk* neighbor = findChunk(x, y, z);
+            bool dependent = neighbor &&
+                             (level < node.level ||
+                              (channel == LightChannel::SKY && dir.y == -1 && node.level == MAX_LIGHT && level == MAX_LIGHT));
+            if (dependent) {
+                // Lit only through the removed node; clear it and keep going
+                setLevel(channel, *neighbor, x, y, z, 0);
+                m_removeQueue.push_back({x, y, z, level});
+            } else {
+                // Lit independently; it refills the cleared area afterwards
+                m_addQueue.push_back({x, y, z, level});
+            }
+        }
+    }
+    m_removeQueue.clear();
+}
+
+void LightEngine::lightChunk(Chunk& chunk) {
+    PROFILE_SCOPE("LightEngine::lightChunk");
+    invalidateCache();
+    glm::ivec3 base = chunk.getPosition() * glm::ivec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+
+    // Sky: full light falls straight down each column until the first opaque block
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            if (getLevel(LightChannel::SKY, base.x + x, base.y + CHUNK_HEIGHT, base.z + z) != MAX_LIGHT) continue;
+            for (int y = CHUNK_HEIGHT - 1; y >= 0 && !isOpaque(chunk.getBlockType(x, y, z)); y--) {
+                chunk.setLight(x, y, z, packLight(MAX_LIGHT, 0));
+            }
+        }
+    }
+
+    // Spread sideways from sky-lit blocks next to darker open ones, and from every lit
+    // border block into the neighbours
+    Chunk::forEachVoxel([&](int x, int y, int z) {
+        if (getSkyLight(chunk.getLight(x, y, z)) != MAX_LIGHT) return;
+
+        bool border = x == 0 || x == CHUNK_SIZE - 1 || z == 0 || z == CHUNK_SIZE - 1 || y == 0;
+        bool spreads = border;
+        for (int i = 0; i < 6 && !spreads; i++) {
+            glm::ivec3 n = glm::ivec3(x, y, z) + DIRECTIONS[i];
+            if (n.y >= CHUNK_HEIGHT) continue;
+            spreads = !isOpaque(chunk.getBlockType(n.x, n.y, n.z)) &&
+                      getSkyLight(chunk.getLight(n.x, n.y, n.z)) < MAX_LIGHT - 1;
+        }
+        if (spreads) {
+            m_addQueue.push_back({base.x + x, base.y + y, base.z + z, MAX_LIGHT});
+        }
+    });
+
+    // Light already in the neighbours flows in across the shared faces
+    std::vector<LightNode> blockSeeds;
+    glm::ivec3 size(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+    for (const glm::ivec3& dir : DIRECTIONS) {
+        glm::ivec3 lo, hi;
+        for (int axis = 0; axis < 3; axis++) {
+            lo[axis] = dir[axis] > 0 ? size[axis] - 1 : 0;
+            hi[axis] = dir[axis] < 0 ? 0 : size[axis] - 1;
+        }
+        for (int x = lo.x; x <= hi.x; x++) {
+            for (int y = lo.y; y <= hi.y; y++) {
+                for (int z = lo.z; z <= hi.z; z++) {
+                    if (isOpaque(chunk.getBlockType(x, y, z))) continue;
+                    glm::ivec3 outside = base + glm::ivec3(x, y, z) + dir;
+                    uint8_t own = chunk.getLight(x, y, z);
+
+                    int sky = getLevel(LightChannel::SKY, outside.x, outside.y, outside.z);
+                    if (sky > getSkyLight(own) + 1) {
+                        m_addQueue.push_back({outside.x, outside.y, outside.z, sky});
+                    }
+                    int block = getLevel(LightChannel::BLOCK, outside.x, outside.y, outside.z);
+                    if (block > getBlockLight(own) + 1) {
+                        blockSeeds.push_back({outside.x, outside.y, outside.z, block});
+                    }
+                }
+            }
+        }
+    }
+    propagateAdd(LightChannel::SKY);
+
+    // Block light: emitters in this chunk plus what came in from the neighbours
+    m_addQueue.swap(blockSeeds);
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int y = 0; y < CHUNK_HEIGHT; y++) {
+            for (int z = 0; z < CHUNK_SIZE; z++) {
+                int emission = getBlockProperties(chunk.getBlockType(x, y, z)).lightEmission;
+                if (emission > 0) {
+                    chunk.setLight(x, y, z, packLight(getSkyLight(chunk.getLight(x, y, z)), emission));
+                    m_addQueue.push_back({base.x + x, base.y + y, base.z + z, emission});
+                }
+            }
+        }
+    }
+    propagateAdd(LightChannel::BLOCK);
+}
+
+void LightEngine::onBlockChanged(int worldX, int worldY, int worldZ, BlockType oldType, BlockType newType) {
+    PROFILE_SCOPE("LightEngine::onBlockChanged");
+    invalidateCache();
+
+    Chunk* chunk = findChunk(worldX, worldY, worldZ);
+    if (!chunk) return;
+
+    for (LightChannel channel : {LightChannel::SKY, LightChannel::BLOCK}) {
+        int oldLevel = getLevel(channel, worldX, worldY, worldZ);
+        bool wasEmitter = channel == LightChannel::BLOCK && getBlockProperties(oldType).lightEmission > 0;
+        int emission = channel == LightChannel::BLOCK ? getBlockProperties(newType).lightEmission : 0;
+
+        // Light that passed through (or came from) this block has to be taken back first
+        if (oldLevel > 0 && (isOpaque(newType) || wasEmitter)) {
+            setLevel(channel, *chunk, worldX, worldY, worldZ, 0);
+            m_removeQueue.push_back({worldX, worldY, worldZ, oldLevel});
+            propagateRemove(channel);
+        }
+
+        if (emission > getLevel(channel, worldX, worldY, worldZ)) {
+            setLevel(channel, *chunk, worldX, worldY, worldZ, emission);
+            m_addQueue.push_back({worldX, worldY, worldZ, emission});
+        }
+
+        // An open block lets the light around it back in
+        if (!isOpaque(newType)) {
+            queueNeighbours(channel, worldX, worldY, worldZ);
+        }
+        propagateAdd(channel);
+    }
+}
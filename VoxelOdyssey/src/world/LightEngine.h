@@ -0,0 +1,54 @@
+#pragma once
+#include "Chunk.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+class World;
+
+enum class LightChannel {
+    SKY,    // 15 under open sky, travels straight down without falling off
+    BLOCK   // Emitted by blocks (BlockProperties::lightEmission)
+};
+
+// Flood-fill voxel lighting over the world's loaded chunks.
+// Light is stored per chunk (Chunk::getLight) and spreads with BFS queues that
+// cross chunk borders freely. Chunks are lit once when they load and then kept up
+// to date incrementally: a block edit only re-floods the area its old and new
+// light could reach. Every chunk whose light changes is marked dirty so the new
+// values get baked into its mesh.
+class LightEngine {
+public:
+    explicit LightEngine(World& world);
+
+    // Light a freshly loaded chunk: sky columns, emitters, and light flowing in
+    // from (and out to) the already loaded neighbours
+    void lightChunk(Chunk& chunk);
+
+    // Incremental update after the block at a world position changed type
+    void onBlockChanged(int worldX, int worldY, int worldZ, BlockType oldType, BlockType newType);
+
+private:
+    struct LightNode {
+        int x, y, z;    // World position
+        int level;
+    };
+
+    World& m_world;
+    std::vector<LightNode> m_addQueue;
+    std::vector<LightNode> m_removeQueue;
+
+    // Last chunk looked up; propagation mostly stays inside one chunk
+    Chunk* m_cachedChunk;
+    glm::ivec3 m_cachedChunkPos;
+    bool m_cacheValid;
+
+    void invalidateCache();
+    Chunk* findChunk(int worldX, int worldY, int worldZ);
+    int getLevel(LightChannel channel, int worldX, int worldY, int worldZ);
+    void setLevel(LightChannel channel, Chunk& chunk, int worldX, int worldY, int worldZ, int level);
+    bool isOpaqueAt(Chunk& chunk, int worldX, int worldY, int worldZ) const;
+
+    void queueNeighbours(LightChannel channel, int worldX, int worldY, int worldZ);
+    void propagateAdd(LightChannel channel);
+    void propagateRemove(LightChannel channel);
+};
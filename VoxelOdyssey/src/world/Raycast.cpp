@@ -1,4 +1,6 @@
 #include "Raycast.h"
+#include "World.h"
+#include "core/Profiler.h"
 #include <cmath>
 #include <algorithm>
 
@@ -59,7 +61,7 @@ RaycastResult Raycast::cast(const glm::vec3& origin, const glm::vec3& direction,
         // Check current block
         BlockType blockType = blockQuery(currentBlock.x, currentBlock.y, currentBlock.z);
         
-        if (blockType != BlockType::AIR) {
+        if (isSolid(blockType)) {
             result.hit = true;
             result.blockPos = currentBlock;
             result.distance = distance;
@@ -102,3 +104,153 @@ glm::ivec3 Raycast::getAdjacentBlock(const glm::ivec3& blockPos, const glm::ivec
     return blockPos + faceNormal;
 }
 
+
+// Rounds toward negative infinity, so negative block coordinates map to the right chunk
+static int floorDiv(int value, int divisor) {
+    return value < 0 ? (value - divisor + 1) / divisor : value / divisor;
+}
+
+RaycastResult Raycast::cast(const glm::vec3& origin, const glm::vec3& direction,
+                            float maxDistance, World& world) {
+    RaycastResult result;
+    result.hit = false;
+    result.distance = maxDistance;
+    
+    glm::vec3 dir = glm::normalize(direction);
+    glm::ivec3 currentBlock(
+        static_cast<int>(std::floor(origin.x)),
+        static_cast<int>(std::floor(origin.y)),
+        static_cast<int>(std::floor(origin.z))
+    );
+    glm::ivec3 step(
+        dir.x > 0 ? 1 : -1,
+        dir.y > 0 ? 1 : -1,
+        dir.z > 0 ? 1 : -1
+    );
+    glm::vec3 deltaDist(
+        dir.x == 0 ? 1e30f : std::abs(1.0f / dir.x),
+        dir.y == 0 ? 1e30f : std::abs(1.0f / dir.y),
+        dir.z == 0 ? 1e30f : std::abs(1.0f / dir.z)
+    );
+    glm::vec3 sideDist;
+    for (int axis = 0; axis < 3; axis++) {
+        sideDist[axis] = dir[axis] < 0 ? (origin[axis] - currentBlock[axis]) * deltaDist[axis]
+                                       : (currentBlock[axis] + 1.0f - origin[axis]) * deltaDist[axis];
+    }
+    
+    const glm::ivec3 chunkSize(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+    glm::ivec3 base(0);  // First block of the current chunk
+    Chunk* chunk = nullptr;
+    bool chunkValid = false;
+    
+    float distance = 0.0f;
+    int side = 0;
+    
+    while (distance < maxDistance) {
+        // Look the chunk up only when the ray has left the previous one; stepping into a
+        // loaded face neighbour just follows its link
+        glm::ivec3 local = currentBlock - base;
+        if (!chunkValid || local.x < 0 || local.x >= CHUNK_SIZE || local.y < 0 || local.y >= CHUNK_HEIGHT ||
+            local.z < 0 || local.z >= CHUNK_SIZE) {
+            glm::ivec3 chunkPos(floorDiv(currentBlock.x, CHUNK_SIZE),
+                                floorDiv(currentBlock.y, CHUNK_HEIGHT),
+                                floorDiv(currentBlock.z, CHUNK_SIZE));
+            int face = chunkValid && chunk ? getNeighborFace(chunkPos - base / chunkSize) : -1;
+            if (face >= 0 && chunk->isNeighborReady(face)) {
+                chunk = chunk->getNeighbor(face);
+            } else {
+                chunk = world.getChunk(chunkPos.x, chunkPos.y, chunkPos.z);
+            }
+            chunkValid = true;
+            base = chunkPos * chunkSize;
+            local = currentBlock - base;
+        }
+        
+        // An empty box around the current block: the whole chunk when it isn't stored
+        // (unloaded or all air), or the run of empty layers the block is in
+        bool empty = false;
+        glm::ivec3 boxMin = base, boxMax = base + chunkSize - 1;
+        if (!chunk) {
+            empty = true;
+        } else if (chunk->isLayerEmpty(local.y)) {
+            int low = local.y, high = local.y;
+            while (low > 0 && chunk->isLayerEmpty(low - 1)) low--;
+            while (high < CHUNK_HEIGHT - 1 && chunk->isLayerEmpty(high + 1)) high++;
+            boxMin.y = base.y + low;
+            boxMax.y = base.y + high;
+            empty = true;
+        }
+        
+        if (empty) {
+            // Walk each axis up to the last block inside the box without looking at
+            // blocks; the regular step below then leaves the box through the right face
+            float exitDist = maxDistance;
+            glm::ivec3 last;
+            for (int axis = 0; axis < 3; axis++) {
+                last[axis] = step[axis] > 0 ? boxMax[axis] : boxMin[axis];
+                if (dir[axis] != 0) {
+                    float boundary = step[axis] > 0 ? boxMax[axis] + 1.0f : static_cast<float>(boxMin[axis]);
+                    exitDist = std::min(exitDist, (boundary - origin[axis]) / dir[axis]);
+                }
+            }
+            if (exitDist >= maxDistance) {
+                break;  // Nothing solid within reach
+            }
+            for (int axis = 0; axis < 3; axis++) {
+                while (sideDist[axis] < exitDist && currentBlock[axis] != last[axis]) {
+                    sideDist[axis] += deltaDist[axis];
+                    currentBlock[axis] += step[axis];
+                }
+            }
+        } else if (isSolid(chunk->getBlockType(local.x, local.y, local.z))) {
+            result.hit = true;
+            result.blockPos = currentBlock;
+            result.distance = distance;
+            if (side == 0) {
+                result.faceNormal = glm::ivec3(-step.x, 0, 0);
+            } else if (side == 1) {
+                result.faceNormal = glm::ivec3(0, -step.y, 0);
+            } else {
+                result.faceNormal = glm::ivec3(0, 0, -step.z);
+            }
+            return result;
+        }
+        
+        // Move to next block
+        if (sideDist.x < sideDist.y && sideDist.x < sideDist.z) {
+            sideDist.x += deltaDist.x;
+            currentBlock.x += step.x;
+            side = 0;
+            distance = sideDist.x - deltaDist.x;
+        } else if (sideDist.y < sideDist.z) {
+            sideDist.y += deltaDist.y;
+            currentBlock.y += step.y;
+            side = 1;
+            distance = sideDist.y - deltaDist.y;
+        } else {
+            sideDist.z += deltaDist.z;
+            currentBlock.z += step.z;
+            side = 2;
+            distance = sideDist.z - deltaDist.z;
+        }
+    }
+    
+    return result;
+}
+
+double Raycast::measureRaysPerSecond(World& world, const glm::vec3& origin, int rayCount, float maxDistance) {
+    if (rayCount <= 0) return 0.0;
+    
+    // Fibonacci lattice: evenly spread directions without clumping at the poles
+    const float goldenAngle = 2.39996323f;
+    uint64_t startNs = Profiler::nowNs();
+    for (int i = 0; i < rayCount; i++) {
+        float y = 1.0f - 2.0f * (i + 0.5f) / rayCount;
+        float radius = std::sqrt(1.0f - y * y);
+        float angle = goldenAngle * i;
+        glm::vec3 direction(std::cos(angle) * radius, y, std::sin(angle) * radius);
+        cast(origin, direction, maxDistance, world);
+    }
+    double seconds = (Profiler::nowNs() - startNs) / 1.0e9;
+    return seconds > 0.0 ? rayCount / seconds : 0.0;
+}
@@ -3,6 +3,8 @@
 #include <glm/glm.hpp>
 #include <functional>
 
+class World;
+
 struct RaycastResult {
     bool hit;
     glm::ivec3 blockPos;      // Position of the hit block
@@ -18,6 +20,15 @@ public:
                              float maxDistance,
                              std::function<BlockType(int, int, int)> blockQuery);
     
+    // Same, reading the world's chunks directly: blocks come from the current chunk
+    // without a map lookup per step, and missing or all-air chunks and runs of empty
+    // layers are crossed in one jump
+    static RaycastResult cast(const glm::vec3& origin, const glm::vec3& direction,
+                              float maxDistance, World& world);
+    
+    // Throughput of the world raycaster: rays spread evenly over the sphere around origin
+    static double measureRaysPerSecond(World& world, const glm::vec3& origin, int rayCount, float maxDistance);
+    
     // Helper to get the adjacent block position (for block placement)
     static glm::ivec3 getAdjacentBlock(const glm::ivec3& blockPos, const glm::ivec3& faceNormal);
 };
@@ -0,0 +1,118 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// Storage orders for a SIZE x HEIGHT x SIZE chunk of voxels. Each maps (x, y, z) to a
+// linear index, and forEach visits every voxel in index order, i.e. the order that
+// walks memory front to back; loops that don't care about order should use it.
+// The order is picked at build time (VOXEL_LAYOUT in CMake, see ChunkVoxelLayout).
+
+// y fastest: every (x, z) column is contiguous, matching the column-at-a-time mesher,
+// terrain generation and lighting
+template<int SIZE, int HEIGHT>
+struct VoxelLayoutXZY {
+    static constexpr int index(int x, int y, int z) { return (x * SIZE + z) * HEIGHT + y; }
+
+    template<typename Fn>
+    static void forEach(Fn&& fn) {
+        int i = 0;
+        for (int x = 0; x < SIZE; x++) {
+            for (int z = 0; z < SIZE; z++) {
+                for (int y = 0; y < HEIGHT; y++) {
+                    fn(x, y, z, i++);
+                }
+            }
+        }
+    }
+};
+
+// x fastest: every y layer is contiguous
+template<int SIZE, int HEIGHT>
+struct VoxelLayoutYZX {
+    static constexpr int index(int x, int y, int z) { return (y * SIZE + z) * SIZE + x; }
+
+    template<typename Fn>
+    static void forEach(Fn&& fn) {
+        int i = 0;
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int z = 0; z < SIZE; z++) {
+                for (int x = 0; x < SIZE; x++) {
+                    fn(x, y, z, i++);
+                }
+            }
+        }
+    }
+};
+
+// Bits needed to store coordinates below value
+constexpr int mortonBitCount(int value) {
+    int bits = 0;
+    while ((1 << bits) < value) bits++;
+    return bits;
+}
+
+// Index bits each value of one axis (0 = y, 1 = z, 2 = x) contributes. Levels
+// interleave y, z, x from the lowest bit; an axis whose bits have run out is skipped.
+template<int SIZE, int HEIGHT, int N>
+constexpr std::array<uint32_t, N> mortonSpread(int axis) {
+    std::array<uint32_t, N> table{};
+    const int horizontalBits = mortonBitCount(SIZE);
+    const int verticalBits = mortonBitCount(HEIGHT);
+    for (int value = 0; value < N; value++) {
+        uint32_t bits = 0;
+        int out = 0;
+        for (int level = 0; level < horizontalBits || level < verticalBits; level++) {
+            for (int a = 0; a < 3; a++) {
+                if (level >= (a == 0 ? verticalBits : horizontalBits)) continue;
+                if (a == axis && ((value >> level) & 1)) bits |= uint32_t(1) << out;
+                out++;
+            }
+        }
+        table[value] = bits;
+    }
+    return table;
+}
+
+// Coordinate along one axis for every index
+template<int SIZE, int HEIGHT>
+constexpr std::array<uint8_t, SIZE * SIZE * HEIGHT> mortonDecode(int axis) {
+    std::array<uint8_t, SIZE * SIZE * HEIGHT> table{};
+    auto xBits = mortonSpread<SIZE, HEIGHT, SIZE>(2);
+    auto yBits = mortonSpread<SIZE, HEIGHT, HEIGHT>(0);
+    auto zBits = mortonSpread<SIZE, HEIGHT, SIZE>(1);
+    for (int x = 0; x < SIZE; x++) {
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int z = 0; z < SIZE; z++) {
+                table[xBits[x] | yBits[y] | zBits[z]] = static_cast<uint8_t>(axis == 0 ? y : axis == 1 ? z : x);
+            }
+        }
+    }
+    return table;
+}
+
+// Bits of x, y and z interleaved (y lowest), so voxels that are close in any direction
+// tend to share a cache line. Once the horizontal bits run out, the rest of y goes on
+// top. Needs power-of-two dimensions.
+template<int SIZE, int HEIGHT>
+struct VoxelLayoutMorton {
+    static_assert((SIZE & (SIZE - 1)) == 0 && (HEIGHT & (HEIGHT - 1)) == 0,
+                  "Morton order needs power-of-two chunk dimensions");
+    static_assert(SIZE <= 256 && HEIGHT <= 256, "Decode tables store coordinates in bytes");
+
+    static constexpr int index(int x, int y, int z) { return X_BITS[x] | Y_BITS[y] | Z_BITS[z]; }
+
+    template<typename Fn>
+    static void forEach(Fn&& fn) {
+        for (int i = 0; i < SIZE * SIZE * HEIGHT; i++) {
+            fn(DECODE_X[i], DECODE_Y[i], DECODE_Z[i], i);
+        }
+    }
+
+private:
+    static constexpr std::array<uint32_t, SIZE> X_BITS = mortonSpread<SIZE, HEIGHT, SIZE>(2);
+    static constexpr std::array<uint32_t, HEIGHT> Y_BITS = mortonSpread<SIZE, HEIGHT, HEIGHT>(0);
+    static constexpr std::array<uint32_t, SIZE> Z_BITS = mortonSpread<SIZE, HEIGHT, SIZE>(1);
+    static constexpr std::array<uint8_t, SIZE * SIZE * HEIGHT> DECODE_X = mortonDecode<SIZE, HEIGHT>(2);
+    static constexpr std::array<uint8_t, SIZE * SIZE * HEIGHT> DECODE_Y = mortonDecode<SIZE, HEIGHT>(0);
+    static constexpr std::array<uint8_t, SIZE * SIZE * HEIGHT> DECODE_Z = mortonDecode<SIZE, HEIGHT>(1);
+};
@@ -1,5 +1,9 @@
 #include "World.h"
 #include "core/Frustum.h"
+#include "core/Profiler.h"
+#include "core/JobSystem.h"
+#include "renderer/UploadRing.h"
+#include <glad/glad.h>
 #include <cmath>
 #include <algorithm>
 #include <fstream>
@@ -8,14 +12,208 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <limits>
 
-World::World() : m_worldName("world1") {
+World::World() : m_worldName("world1"), m_persistenceEnabled(true), m_trackChunkLoads(false),
+                 m_renderDistance(4), m_lightEngine(*this), m_loadCenter(0), m_loadNearRange(0), m_loadCursor(0),
+                 m_unloadScanPending(false) {
+    rebuildLoadOrder();
 }
 
 World::~World() {
+    // Generation jobs write into storage owned by m_pendingChunks
+    for (auto& pair : m_pendingChunks) {
+        JobSystem::wait(pair.second.job);
+    }
+    m_pendingChunks.clear();
     m_chunks.clear();
 }
 
+// Rounds toward negative infinity, so negative block coordinates map to the right chunk
+static int floorDiv(int value, int divisor) {
+    return value < 0 ? (value - divisor + 1) / divisor : value / divisor;
+}
+
+// Simple noise function for terrain generation
+static float noise2D(float x, float z) {
+    return std::sin(x * 0.1f) * std::cos(z * 0.1f) + 
+           0.5f * std::sin(x * 0.2f) * std::cos(z * 0.2f) +
+           0.25f * std::sin(x * 0.4f) * std::cos(z * 0.4f);
+}
+
+// Improved 3D noise for caves - multiple octaves for better variation
+static float noise3D(float x, float y, float z) {
+    return std::sin(x * 0.1f) * std::cos(y * 0.1f) * std::sin(z * 0.1f) +
+           0.5f * std::sin(x * 0.2f) * std::cos(y * 0.2f) * std::sin(z * 0.2f) +
+           0.25f * std::sin(x * 0.4f) * std::cos(y * 0.4f) * std::sin(z * 0.4f);
+}
+
+// Cave density function - creates more varied cave shapes
+static float caveDensity(float x, float y, float z) {
+    // Use multiple noise functions for varied cave systems
+    float n1 = noise3D(x * 0.12f, y * 0.12f, z * 0.12f);
+    float n2 = noise3D(x * 0.25f, y * 0.25f, z * 0.25f);
+    float n3 = noise3D(x * 0.5f, y * 0.5f, z * 0.5f);
+    
+    // Combine with different weights
+    float density = n1 * 0.6f + n2 * 0.3f + n3 * 0.1f;
+    
+    // Add vertical bias - more caves at certain depths
+    float depthFactor = 1.0f - std::abs((y - 20.0f) / 30.0f); // Peak around y=20
+    depthFactor = std::max(0.0f, depthFactor);
+    
+    return density * (0.5f + 0.5f * depthFactor);
+}
+
+// Ore generation noise
+static float oreNoise(float x, float y, float z) {
+    return std::sin(x * 0.3f) * std::cos(y * 0.3f) * std::sin(z * 0.3f);
+}
+
+// Canopy reach around the top of the trunk; trees rooted this far outside a column can
+// still put leaves in it
+static constexpr int TREE_LEAF_RADIUS = 2;
+// Stalactites and stalagmites grow up to this many blocks from their stone
+static constexpr int CAVE_FEATURE_LENGTH = 3;
+
+// Generation runs in stages, each a pure function of position and the stages before
+// it: base terrain, then carving, then ores, then decoration (cave features, trees).
+// Nothing reads a neighbouring chunk, so any chunk can be generated on any thread in
+// any order, and one whose decoration reaches across a border gets the same blocks on
+// both sides.
+
+// Stage 1, base terrain: the column's biome layers over solid stone
+static BlockType getBaseBlock(const TerrainColumn& column, int worldY) {
+    int groundHeight = column.groundHeight;
+    if (worldY < groundHeight - 4) {
+        return BlockType::STONE;
+    } else if (worldY < groundHeight) {
+        return column.dirtBlock;
+    } else if (worldY == groundHeight) {
+        return column.surfaceBlock;
+    }
+    return BlockType::AIR;
+}
+
+// Stage 2, carving: caves, except under the ocean
+static bool isCarved(const TerrainColumn& column, int worldX, int worldY, int worldZ) {
+    if (column.biome == Biome::OCEAN || worldY >= column.groundHeight - 5 || worldY <= 5) {
+        return false;
+    }
+    return caveDensity(worldX * 0.15f, worldY * 0.15f, worldZ * 0.15f) > 0.35f;
+}
+
+// Stage 3, ores: veins in the stone left after carving
+static BlockType getOreBlock(int worldX, int worldY, int worldZ) {
+    // Ore generation based on depth and noise
+    float oreValue = oreNoise(worldX * 0.2f, worldY * 0.2f, worldZ * 0.2f);
+    
+    // Coal ore - common, found at all depths
+    if (oreValue > 0.7f && (worldX * 13 + worldY * 17 + worldZ * 19) % 100 < 3) {
+        return BlockType::COAL_ORE;
+    }
+    
+    // Iron ore - less common, found deeper
+    if (worldY < 30 && oreValue > 0.75f && (worldX * 13 + worldY * 17 + worldZ * 19) % 100 < 2) {
+        return BlockType::IRON_ORE;
+    }
+    return BlockType::STONE;
+}
+
+// Stages 1-3 for a run of blocks in one column, from worldY upward
+static void generateColumnTerrain(const TerrainColumn& column, int worldX, int worldY, int worldZ,
+                                  BlockType* blocks, int count) {
+    for (int i = 0; i < count; i++) {
+        blocks[i] = getBaseBlock(column, worldY + i);
+    }
+    for (int i = 0; i < count; i++) {
+        if (isSolid(blocks[i]) && isCarved(column, worldX, worldY + i, worldZ)) {
+            blocks[i] = BlockType::AIR;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        if (blocks[i] == BlockType::STONE) {
+            blocks[i] = getOreBlock(worldX, worldY + i, worldZ);
+        }
+    }
+}
+
+// Stage 4, decoration: stalactites (hanging from ceilings) and stalagmites (growing
+// from floors) in caves. terrain holds stages 1-3 for the column from
+// CAVE_FEATURE_LENGTH blocks below the chunk to as far above it; blocks is the chunk's
+// part of the column. Features are decided on the unmodified terrain, so one crossing
+// a chunk boundary comes out the same on both sides.
+static void addCaveFeatures(const BlockType* terrain, BlockType* blocks, int worldX, int chunkBaseY,
+                            int worldZ, int groundHeight) {
+    const int count = CHUNK_HEIGHT + 2 * CAVE_FEATURE_LENGTH;
+    for (int i = 1; i < count - 1; i++) {
+        int worldY = chunkBaseY - CAVE_FEATURE_LENGTH + i;
+        if (isSolid(terrain[i]) || worldY >= groundHeight - 5 || worldY <= 5 ||
+            (worldX * 7 + worldY * 11 + worldZ * 13) % 200 >= 2) {
+            continue;
+        }
+        
+        int length = 1 + (worldX + worldZ) % 3; // 1-3 blocks long
+        // Down from stone above, then up from stone below
+        for (int step : {-1, 1}) {
+            if (terrain[i - step] != BlockType::STONE) continue;
+            for (int n = 0, j = i; n < length && j >= 0 && j < count && !isSolid(terrain[j]); n++, j += step) {
+                int y = j - CAVE_FEATURE_LENGTH;
+                if (y >= 0 && y < CHUNK_HEIGHT) {
+                    blocks[y] = BlockType::STONE;
+                }
+            }
+        }
+    }
+}
+
+// Random tree placement: a tree grows where the roll comes in under the biome's chance
+static constexpr int MAX_TREE_CHANCE = 8;   // Forests; no biome gets more
+static int getTreeRoll(int worldX, int worldZ) {
+    return (worldX * 7 + worldZ * 11) % 47;
+}
+
+// Trunk height of the tree growing on a column, 0 for none
+static int getTreeHeight(const TerrainColumn& column, int worldX, int worldZ) {
+    int treeChance = 0;
+    if (column.biome == Biome::FOREST) {
+        treeChance = MAX_TREE_CHANCE; // ~17% chance in forests
+    } else if (column.biome == Biome::GRASSLAND) {
+        treeChance = 2; // ~4% chance in grasslands
+    }
+    // No trees in desert, snow, or ocean
+    
+    if (treeChance == 0 || getTreeRoll(worldX, worldZ) >= treeChance) {
+        return 0;
+    }
+    return 4 + ((worldX + worldZ) % 3 + 3) % 3; // Vary height
+}
+
+// Stamp the part of a tree that falls inside the chunk; base is the lowest trunk block
+// in chunk-local coordinates
+static void placeTree(Chunk& chunk, const glm::ivec3& base, int height) {
+    // Trunk; always wins over leaves, whichever tree is placed first
+    for (int i = 0; i < height; i++) {
+        chunk.setBlock(base.x, base.y + i, base.z, BlockType::WOOD);
+    }
+    
+    // Leaves (simple sphere)
+    int leafY = base.y + height;
+    for (int dx = -TREE_LEAF_RADIUS; dx <= TREE_LEAF_RADIUS; dx++) {
+        for (int dz = -TREE_LEAF_RADIUS; dz <= TREE_LEAF_RADIUS; dz++) {
+            for (int dy = 0; dy <= TREE_LEAF_RADIUS; dy++) {
+                int distSq = dx*dx + dz*dz + dy*dy;
+                // Don't overwrite trunk or terrain (outside the chunk reads as air and
+                // the write is dropped)
+                if (distSq <= TREE_LEAF_RADIUS * TREE_LEAF_RADIUS &&
+                    !isSolid(chunk.getBlockType(base.x + dx, leafY + dy, base.z + dz))) {
+                    chunk.setBlock(base.x + dx, leafY + dy, base.z + dz, BlockType::LEAVES);
+                }
+            }
+        }
+    }
+}
+
 glm::ivec3 World::worldToChunk(int x, int y, int z) const {
     int chunkX = x < 0 ? (x - CHUNK_SIZE + 1) / CHUNK_SIZE : x / CHUNK_SIZE;
     int chunkY = y < 0 ? (y - CHUNK_HEIGHT + 1) / CHUNK_HEIGHT : y / CHUNK_HEIGHT;
@@ -33,30 +231,246 @@ glm::ivec3 World::worldToBlock(int x, int y, int z) const {
 Chunk* World::getOrCreateChunk(int chunkX, int chunkY, int chunkZ) {
     ChunkKey key{chunkX, chunkY, chunkZ};
     
+    // Edited while still generating: finish it here rather than generate it twice
+    auto pendingIt = m_pendingChunks.find(key);
+    if (pendingIt != m_pendingChunks.end()) {
+        JobSystem::wait(pendingIt->second.job);
+        installPendingChunk(pendingIt);
+    }
+    
     auto it = m_chunks.find(key);
-    if (it != m_chunks.end()) {
+    if (it != m_chunks.end() && it->second) {
         return it->second.get();
     }
     
+    if (it == m_chunks.end()) {
+        if (Chunk* chunk = streamChunk(chunkX, chunkY, chunkZ)) {
+            return chunk;
+        }
+    }
+    
+    // Known to be all air; give it real storage now that something is placed in it
+    auto chunk = ChunkPool::acquire(glm::ivec3(chunkX, chunkY, chunkZ), true);
+    Chunk* chunkPtr = chunk.get();
+    m_chunks[key] = std::move(chunk);
+    linkChunk(key);
+    m_culler.add(chunkPtr);
+    markChunkDirty(*chunkPtr);
+    m_lightEngine.lightChunk(*chunkPtr);
+    return chunkPtr;
+}
+
+Chunk* World::streamChunk(int chunkX, int chunkY, int chunkZ) {
+    uint64_t startNs = m_trackChunkLoads ? Profiler::nowNs() : 0;
+    
+    // Loading and generation both write every block, so recycled storage isn't cleared first
+    auto chunk = ChunkPool::acquire(glm::ivec3(chunkX, chunkY, chunkZ), false);
+    
     // Try to load chunk from disk first
-    auto chunk = std::make_unique<Chunk>(glm::ivec3(chunkX, chunkY, chunkZ));
-    bool loaded = loadChunk(*chunk, chunkX, chunkY, chunkZ, m_worldName);
+    bool loaded = m_persistenceEnabled && loadChunk(*chunk, chunkX, chunkY, chunkZ, m_worldName);
     
-    // If not loaded, generate new terrain
+    // If not loaded, generate new terrain; nothing is generated above the column's top
     if (!loaded) {
-        generateTerrain(*chunk);
+        const ChunkColumn& column = getOrCreateColumn(chunkX, chunkZ);
+        if (chunkY * CHUNK_HEIGHT <= column.maxGeneratedY) {
+            generateTerrain(*chunk, column);
+            Profiler::increment(ProfileCounter::CHUNKS_GENERATED);
+        } else {
+            chunk->clearBlocks();
+        }
     }
     
-    // Generate mesh with world block query function
-    auto worldQuery = [this](int x, int y, int z) { return this->getBlock(x, y, z); };
-    chunk->generateMesh(worldQuery);
+    Chunk* chunkPtr = installChunk(ChunkKey{chunkX, chunkY, chunkZ}, std::move(chunk));
+    
+    if (m_trackChunkLoads) {
+        m_chunkLoadTimes.push_back((Profiler::nowNs() - startNs) / 1.0e6f);
+    }
     
+    return chunkPtr;
+}
+
+Chunk* World::installChunk(const ChunkKey& key, ChunkPool::Handle chunk) {
+    // Edits can load chunks anywhere; the unload scan only runs when it has something to find
+    if (isDistant(key, m_loadCenter)) {
+        m_unloadScanPending = true;
+    }
+    
+    if (chunk->isAllAir()) {
+        m_chunks[key] = nullptr;
+        linkChunk(key);
+        return nullptr;
+    }
+    
+    // Meshed later, once the neighbours it is waiting for have loaded (meshIfReady)
     Chunk* chunkPtr = chunk.get();
     m_chunks[key] = std::move(chunk);
-    
+    linkChunk(key);
+    m_culler.add(chunkPtr);
+    markChunkDirty(*chunkPtr);
+    m_lightEngine.lightChunk(*chunkPtr);
     return chunkPtr;
 }
 
+void World::requestChunk(int chunkX, int chunkY, int chunkZ) {
+    ChunkKey key{chunkX, chunkY, chunkZ};
+    
+    // Saved chunks are read straight away; only generation is worth handing to a worker
+    if (m_persistenceEnabled && std::filesystem::exists(getChunkFilePath(chunkX, chunkY, chunkZ, m_worldName))) {
+        streamChunk(chunkX, chunkY, chunkZ);
+        meshAfterLoad(key);
+        return;
+    }
+    
+    requestColumn(chunkX, chunkZ);
+    ChunkKey columnKey{chunkX, 0, chunkZ};
+    std::shared_ptr<const ChunkColumn> column = m_columns[columnKey];
+    std::vector<JobHandle> dependencies;
+    auto columnJob = m_columnJobs.find(columnKey);
+    if (columnJob != m_columnJobs.end()) {
+        dependencies.push_back(columnJob->second);
+    }
+    
+    // Loading and generation both write every block, so recycled storage isn't cleared first
+    PendingChunk pending;
+    pending.chunk = ChunkPool::acquire(glm::ivec3(chunkX, chunkY, chunkZ), false);
+    pending.requestNs = m_trackChunkLoads ? Profiler::nowNs() : 0;
+    Chunk* chunk = pending.chunk.get();
+    pending.job = JobSystem::submit([chunk, column]() {
+        if (chunk->getPosition().y * CHUNK_HEIGHT <= column->maxGeneratedY) {
+            generateTerrain(*chunk, *column);
+            Profiler::increment(ProfileCounter::CHUNKS_GENERATED);
+        } else {
+            chunk->clearBlocks();
+        }
+    }, dependencies);
+    m_pendingChunks[key] = std::move(pending);
+}
+
+int World::installFinishedChunks(uint64_t deadlineNs) {
+    // At least one chunk per frame, so progress is made even on a slow frame
+    int installed = 0;
+    for (auto it = m_pendingChunks.begin(); it != m_pendingChunks.end();) {
+        if (installed > 0 && (Profiler::nowNs() >= deadlineNs || !UploadRing::hasFrameBudget())) {
+            break;
+        }
+        if (!JobSystem::isDone(it->second.job)) {
+            ++it;
+            continue;
+        }
+        // Out of range by now: dropped instead of being installed, lit and meshed
+        if (isDistant(it->first, m_loadCenter)) {
+            it = m_pendingChunks.erase(it);
+            continue;
+        }
+        auto next = std::next(it);
+        installPendingChunk(it);
+        it = next;
+        installed++;
+    }
+    return installed;
+}
+
+void World::installPendingChunk(std::unordered_map<ChunkKey, PendingChunk>::iterator it) {
+    ChunkKey key = it->first;
+    ChunkPool::Handle chunk = std::move(it->second.chunk);
+    uint64_t requestNs = it->second.requestNs;
+    m_pendingChunks.erase(it);
+    
+    installChunk(key, std::move(chunk));
+    meshAfterLoad(key);
+    
+    if (m_trackChunkLoads) {
+        m_chunkLoadTimes.push_back((Profiler::nowNs() - requestNs) / 1.0e6f);
+    }
+}
+
+void World::sampleColumn(ChunkColumn& column, int chunkX, int chunkZ) {
+    PROFILE_SCOPE("World::sampleColumn");
+    column.minGroundY = std::numeric_limits<int>::max();
+    column.maxGeneratedY = std::numeric_limits<int>::min();
+    
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            TerrainColumn surface = sampleTerrainColumn(chunkX * CHUNK_SIZE + x, chunkZ * CHUNK_SIZE + z);
+            column.surface[x * CHUNK_SIZE + z] = surface;
+            column.minGroundY = std::min(column.minGroundY, surface.groundHeight);
+            column.maxGeneratedY = std::max(column.maxGeneratedY, surface.groundHeight);
+        }
+    }
+    
+    // Trees rooted up to a canopy radius outside the column reach into it too. Outside
+    // columns only need sampling when the placement roll allows a tree at all.
+    for (int x = -TREE_LEAF_RADIUS; x < CHUNK_SIZE + TREE_LEAF_RADIUS; x++) {
+        for (int z = -TREE_LEAF_RADIUS; z < CHUNK_SIZE + TREE_LEAF_RADIUS; z++) {
+            int worldX = chunkX * CHUNK_SIZE + x;
+            int worldZ = chunkZ * CHUNK_SIZE + z;
+            bool inside = x >= 0 && x < CHUNK_SIZE && z >= 0 && z < CHUNK_SIZE;
+            if (!inside && getTreeRoll(worldX, worldZ) >= MAX_TREE_CHANCE) continue;
+            
+            TerrainColumn surface = inside ? column.surface[x * CHUNK_SIZE + z] : sampleTerrainColumn(worldX, worldZ);
+            int height = getTreeHeight(surface, worldX, worldZ);
+            if (height == 0) continue;
+            
+            TreeRoot tree{glm::ivec3(worldX, surface.groundHeight + 1, worldZ), height};
+            column.trees.push_back(tree);
+            column.maxGeneratedY = std::max(column.maxGeneratedY, tree.base.y + height + TREE_LEAF_RADIUS);
+        }
+    }
+}
+
+void World::requestColumn(int chunkX, int chunkZ) {
+    ChunkKey key{chunkX, 0, chunkZ};
+    if (m_columns.count(key)) return;
+    
+    auto column = std::make_shared<ChunkColumn>();
+    m_columns[key] = column;
+    // Every chunk of the column waits on this, so it goes ahead of queued chunks
+    m_columnJobs[key] = JobSystem::submit([column, chunkX, chunkZ]() { sampleColumn(*column, chunkX, chunkZ); },
+                                          {}, JobPriority::HIGH);
+}
+
+const ChunkColumn* World::findReadyColumn(int chunkX, int chunkZ) {
+    ChunkKey key{chunkX, 0, chunkZ};
+    auto it = m_columns.find(key);
+    if (it == m_columns.end()) return nullptr;
+    
+    auto jobIt = m_columnJobs.find(key);
+    if (jobIt != m_columnJobs.end()) {
+        if (!JobSystem::isDone(jobIt->second)) return nullptr;
+        finishColumn(key, *it->second);
+    }
+    return it->second.get();
+}
+
+ChunkColumn& World::getOrCreateColumn(int chunkX, int chunkZ) {
+    ChunkKey key{chunkX, 0, chunkZ};
+    requestColumn(chunkX, chunkZ);
+    ChunkColumn& column = *m_columns[key];
+    
+    auto jobIt = m_columnJobs.find(key);
+    if (jobIt != m_columnJobs.end()) {
+        JobSystem::wait(jobIt->second);
+        finishColumn(key, column);
+    }
+    return column;
+}
+
+void World::finishColumn(const ChunkKey& key, ChunkColumn& column) {
+    m_columnJobs.erase(key);
+    column.maxBlockY = column.maxGeneratedY;
+    
+    // Player builds can rise above anything generated. Blocks are only ever placed
+    // against existing ones, so edited chunks form a contiguous stack above the terrain
+    // that can be found by probing upward.
+    int topChunk = floorDiv(column.maxBlockY, CHUNK_HEIGHT);
+    while (getChunk(key.x, topChunk + 1, key.z) ||
+           (m_persistenceEnabled &&
+            std::filesystem::exists(getChunkFilePath(key.x, topChunk + 1, key.z, m_worldName)))) {
+        topChunk++;
+        column.maxBlockY = (topChunk + 1) * CHUNK_HEIGHT - 1;
+    }
+}
+
 Chunk* World::getChunk(int chunkX, int chunkY, int chunkZ) {
     ChunkKey key{chunkX, chunkY, chunkZ};
     auto it = m_chunks.find(key);
@@ -77,12 +491,47 @@ BlockType World::getBlock(int worldX, int worldY, int worldZ) {
     return BlockType::AIR;
 }
 
+uint8_t World::getLight(int worldX, int worldY, int worldZ) {
+    glm::ivec3 chunkPos = worldToChunk(worldX, worldY, worldZ);
+    glm::ivec3 blockPos = worldToBlock(worldX, worldY, worldZ);
+    
+    auto it = m_chunks.find(ChunkKey{chunkPos.x, chunkPos.y, chunkPos.z});
+    if (it != m_chunks.end()) {
+        if (it->second) {
+            return it->second->getLight(blockPos.x, blockPos.y, blockPos.z);
+        }
+        // Stored as all air, so nothing in it blocks the sky
+        return packLight(MAX_LIGHT, 0);
+    }
+    
+    // Not loaded: open sky above the terrain surface, dark below it
+    int surfaceY;
+    if (const ChunkColumn* column = findReadyColumn(chunkPos.x, chunkPos.z)) {
+        surfaceY = column->surface[blockPos.x * CHUNK_SIZE + blockPos.z].groundHeight;
+    } else {
+        surfaceY = sampleTerrainColumn(worldX, worldZ).groundHeight;
+    }
+    return worldY > surfaceY ? packLight(MAX_LIGHT, 0) : 0;
+}
+
 void World::setBlock(int worldX, int worldY, int worldZ, BlockType type) {
     glm::ivec3 chunkPos = worldToChunk(worldX, worldY, worldZ);
     glm::ivec3 blockPos = worldToBlock(worldX, worldY, worldZ);
     
+    if (type == BlockType::AIR) {
+        // Clearing a block in a chunk already known to be all air changes nothing
+        auto it = m_chunks.find(ChunkKey{chunkPos.x, chunkPos.y, chunkPos.z});
+        if (it != m_chunks.end() && !it->second) return;
+    } else {
+        // Keep the column's top-of-terrain index covering player builds
+        ChunkColumn& column = getOrCreateColumn(chunkPos.x, chunkPos.z);
+        column.maxBlockY = std::max(column.maxBlockY, worldY);
+    }
+    
     Chunk* chunk = getOrCreateChunk(chunkPos.x, chunkPos.y, chunkPos.z);
+    BlockType oldType = chunk->getBlockType(blockPos.x, blockPos.y, blockPos.z);
     chunk->setBlock(blockPos.x, blockPos.y, blockPos.z, type);
+    m_lightEngine.onBlockChanged(worldX, worldY, worldZ, oldType, type);
     
     // Mark this chunk and adjacent chunks as dirty (in case block is on border)
     markChunkDirty(worldX, worldY, worldZ);
@@ -93,173 +542,70 @@ void World::setBlock(int worldX, int worldY, int worldZ, BlockType type) {
 
 void World::markChunkDirty(int worldX, int worldY, int worldZ) {
     glm::ivec3 chunkPos = worldToChunk(worldX, worldY, worldZ);
+    glm::ivec3 blockPos = worldToBlock(worldX, worldY, worldZ);
     
     // Mark the chunk containing this block
     Chunk* chunk = getChunk(chunkPos.x, chunkPos.y, chunkPos.z);
     if (chunk) {
-        chunk->markDirty();
-    }
-    
-    // Mark adjacent chunks if block is on border
-    glm::ivec3 blockPos = worldToBlock(worldX, worldY, worldZ);
-    
-    if (blockPos.x == 0) {
-        Chunk* adjChunk = getChunk(chunkPos.x - 1, chunkPos.y, chunkPos.z);
-        if (adjChunk) adjChunk->markDirty();
-    } else if (blockPos.x == CHUNK_SIZE - 1) {
-        Chunk* adjChunk = getChunk(chunkPos.x + 1, chunkPos.y, chunkPos.z);
-        if (adjChunk) adjChunk->markDirty();
+        markChunkDirty(*chunk);
     }
     
-    if (blockPos.y == 0) {
-        Chunk* adjChunk = getChunk(chunkPos.x, chunkPos.y - 1, chunkPos.z);
-        if (adjChunk) adjChunk->markDirty();
-    } else if (blockPos.y == CHUNK_HEIGHT - 1) {
-        Chunk* adjChunk = getChunk(chunkPos.x, chunkPos.y + 1, chunkPos.z);
-        if (adjChunk) adjChunk->markDirty();
-    }
-    
-    if (blockPos.z == 0) {
-        Chunk* adjChunk = getChunk(chunkPos.x, chunkPos.y, chunkPos.z - 1);
-        if (adjChunk) adjChunk->markDirty();
-    } else if (blockPos.z == CHUNK_SIZE - 1) {
-        Chunk* adjChunk = getChunk(chunkPos.x, chunkPos.y, chunkPos.z + 1);
-        if (adjChunk) adjChunk->markDirty();
+    // Mark adjacent chunks if block is on border; a stored chunk knows its neighbours
+    const glm::ivec3 size(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+    for (int axis = 0; axis < 3; axis++) {
+        int direction = blockPos[axis] == 0 ? -1 : (blockPos[axis] == size[axis] - 1 ? 1 : 0);
+        if (direction == 0) continue;
+        
+        glm::ivec3 offset(0);
+        offset[axis] = direction;
+        Chunk* adjChunk = chunk ? chunk->getNeighbor(getNeighborFace(offset))
+                                : getChunk(chunkPos.x + offset.x, chunkPos.y + offset.y, chunkPos.z + offset.z);
+        if (adjChunk) markChunkDirty(*adjChunk);
     }
 }
 
-// Simple noise function for terrain generation
-static float noise2D(float x, float z) {
-    return std::sin(x * 0.1f) * std::cos(z * 0.1f) + 
-           0.5f * std::sin(x * 0.2f) * std::cos(z * 0.2f) +
-           0.25f * std::sin(x * 0.4f) * std::cos(z * 0.4f);
-}
-
-// Biome noise for determining biome type
-static float biomeNoise(float x, float z) {
-    return std::sin(x * 0.05f) * std::cos(z * 0.05f) + 
-           0.5f * std::sin(x * 0.1f) * std::cos(z * 0.1f);
-}
-
-// Improved 3D noise for caves - multiple octaves for better variation
-static float noise3D(float x, float y, float z) {
-    return std::sin(x * 0.1f) * std::cos(y * 0.1f) * std::sin(z * 0.1f) +
-           0.5f * std::sin(x * 0.2f) * std::cos(y * 0.2f) * std::sin(z * 0.2f) +
-           0.25f * std::sin(x * 0.4f) * std::cos(y * 0.4f) * std::sin(z * 0.4f);
+void World::markChunkDirty(Chunk& chunk) {
+    chunk.markDirty();
+    glm::ivec3 position = chunk.getPosition();
+    m_dirtyChunks.insert(ChunkKey{position.x, position.y, position.z});
 }
 
-// Cave density function - creates more varied cave shapes
-static float caveDensity(float x, float y, float z) {
-    // Use multiple noise functions for varied cave systems
-    float n1 = noise3D(x * 0.12f, y * 0.12f, z * 0.12f);
-    float n2 = noise3D(x * 0.25f, y * 0.25f, z * 0.25f);
-    float n3 = noise3D(x * 0.5f, y * 0.5f, z * 0.5f);
-    
-    // Combine with different weights
-    float density = n1 * 0.6f + n2 * 0.3f + n3 * 0.1f;
-    
-    // Add vertical bias - more caves at certain depths
-    float depthFactor = 1.0f - std::abs((y - 20.0f) / 30.0f); // Peak around y=20
-    depthFactor = std::max(0.0f, depthFactor);
-    
-    return density * (0.5f + 0.5f * depthFactor);
-}
-
-// Ore generation noise
-static float oreNoise(float x, float y, float z) {
-    return std::sin(x * 0.3f) * std::cos(y * 0.3f) * std::sin(z * 0.3f);
-}
-
-// Generate a tree at given position
-static void generateTree(Chunk& chunk, int x, int y, int z) {
-    // Trunk (4-6 blocks tall)
-    int treeHeight = 4 + (x + z) % 3; // Vary height
-    for (int i = 0; i < treeHeight && y + i < CHUNK_HEIGHT; i++) {
-        chunk.setBlock(x, y + i, z, BlockType::WOOD);
-    }
-    
-    // Leaves (simple sphere)
-    int leafY = y + treeHeight;
-    for (int dx = -2; dx <= 2; dx++) {
-        for (int dz = -2; dz <= 2; dz++) {
-            for (int dy = 0; dy <= 2; dy++) {
-                int distSq = dx*dx + dz*dz + dy*dy;
-                if (distSq <= 4 && x + dx >= 0 && x + dx < CHUNK_SIZE &&
-                    z + dz >= 0 && z + dz < CHUNK_SIZE &&
-                    leafY + dy < CHUNK_HEIGHT) {
-                    // Don't overwrite trunk
-                    if (chunk.getBlockType(x + dx, leafY + dy, z + dz) != BlockType::WOOD) {
-                        chunk.setBlock(x + dx, leafY + dy, z + dz, BlockType::LEAVES);
-                    }
-                }
+void World::linkChunk(const ChunkKey& key) {
+    Chunk* chunk = m_chunks[key].get();
+    for (int face = 0; face < CHUNK_NEIGHBOR_COUNT; face++) {
+        glm::ivec3 offset = getFaceOffset(face);
+        auto it = m_chunks.find(ChunkKey{key.x + offset.x, key.y + offset.y, key.z + offset.z});
+        if (it == m_chunks.end()) continue;
+        
+        Chunk* neighbor = it->second.get();
+        if (chunk) {
+            chunk->setNeighbor(face, neighbor, true);
+        }
+        if (neighbor) {
+            neighbor->setNeighbor(getOppositeFace(face), chunk, true);
+            // A neighbour meshed before this chunk existed took its border to be open air
+            if (chunk) {
+                markChunkDirty(*neighbor);
             }
         }
     }
 }
 
-// Generate ore veins in stone
-static void generateOre(Chunk& chunk, int x, int y, int z, int worldX, int worldY, int worldZ) {
-    // Only generate ore in stone
-    if (chunk.getBlockType(x, y, z) != BlockType::STONE) {
-        return;
-    }
-    
-    // Ore generation based on depth and noise
-    float oreValue = oreNoise(worldX * 0.2f, worldY * 0.2f, worldZ * 0.2f);
-    
-    // Coal ore - common, found at all depths
-    if (oreValue > 0.7f && (worldX * 13 + worldY * 17 + worldZ * 19) % 100 < 3) {
-        chunk.setBlock(x, y, z, BlockType::COAL_ORE);
-        return;
-    }
-    
-    // Iron ore - less common, found deeper
-    if (worldY < 30 && oreValue > 0.75f && (worldX * 13 + worldY * 17 + worldZ * 19) % 100 < 2) {
-        chunk.setBlock(x, y, z, BlockType::IRON_ORE);
-        return;
-    }
-}
-
-// Generate stalactites (hanging from ceiling) and stalagmites (growing from floor)
-static void generateStalactites(Chunk& chunk, int x, int y, int z, int worldX, int worldY, int worldZ) {
-    // Only in caves (air blocks)
-    if (chunk.getBlockType(x, y, z) != BlockType::AIR) {
-        return;
-    }
-    
-    // Check if there's stone above (stalactite) or below (stalagmite)
-    bool stoneAbove = (y + 1 < CHUNK_HEIGHT && chunk.getBlockType(x, y + 1, z) == BlockType::STONE);
-    bool stoneBelow = (y - 1 >= 0 && chunk.getBlockType(x, y - 1, z) == BlockType::STONE);
-    
-    // Stalactite (hanging from ceiling)
-    if (stoneAbove && (worldX * 7 + worldY * 11 + worldZ * 13) % 200 < 2) {
-        int length = 1 + (worldX + worldZ) % 3; // 1-3 blocks long
-        for (int i = 0; i < length && y - i >= 0; i++) {
-            if (chunk.getBlockType(x, y - i, z) == BlockType::AIR) {
-                chunk.setBlock(x, y - i, z, BlockType::STONE);
-            } else {
-                break;
-            }
-        }
-    }
-    
-    // Stalagmite (growing from floor)
-    if (stoneBelow && (worldX * 7 + worldY * 11 + worldZ * 13) % 200 < 2) {
-        int length = 1 + (worldX + worldZ) % 3; // 1-3 blocks long
-        for (int i = 0; i < length && y + i < CHUNK_HEIGHT; i++) {
-            if (chunk.getBlockType(x, y + i, z) == BlockType::AIR) {
-                chunk.setBlock(x, y + i, z, BlockType::STONE);
-            } else {
-                break;
-            }
+void World::unlinkChunk(const ChunkKey& key) {
+    for (int face = 0; face < CHUNK_NEIGHBOR_COUNT; face++) {
+        glm::ivec3 offset = getFaceOffset(face);
+        Chunk* neighbor = getChunk(key.x + offset.x, key.y + offset.y, key.z + offset.z);
+        if (neighbor) {
+            neighbor->setNeighbor(getOppositeFace(face), nullptr, false);
         }
     }
 }
 
-Biome World::determineBiome(int worldX, int worldZ, float height) const {
-    // Use biome noise to create regions
-    float biomeValue = biomeNoise(worldX, worldZ);
-    float distance = std::sqrt(worldX * worldX + worldZ * worldZ);
+Biome World::determineBiome(int worldX, int worldZ, float height) {
+    // Biome noise and distance change slowly, so they come from the coarse climate map
+    Climate climate = BiomeMap::getClimate(worldX, worldZ);
+    float biomeValue = climate.biomeValue;
+    float distance = climate.distance;
     
     // Ocean biome: low-lying areas
     if (height < 28.0f) {
@@ -285,217 +631,385 @@ Biome World::determineBiome(int worldX, int worldZ, float height) const {
     return Biome::GRASSLAND;
 }
 
-void World::generateTerrain(Chunk& chunk) {
-    glm::ivec3 chunkPos = chunk.getPosition();
+TerrainColumn World::sampleTerrainColumn(int worldX, int worldZ) {
+    // Height map with noise
+    float heightNoise = noise2D(worldX, worldZ);
+    float baseHeight = 32.0f;
+    float heightVariation = 12.0f;
+    float height = baseHeight + heightVariation * heightNoise;
+    int groundHeight = static_cast<int>(height);
+    
+    // Determine biome
+    Biome biome = determineBiome(worldX, worldZ, height);
+    
+    // Adjust height variation based on biome
+    if (biome == Biome::DESERT) {
+        heightVariation = 4.0f;
+        height = baseHeight + heightVariation * heightNoise;
+        groundHeight = static_cast<int>(height);
+    } else if (biome == Biome::OCEAN) {
+        heightVariation = 2.0f;
+        height = 26.0f + heightVariation * heightNoise; // Lower base for ocean
+        groundHeight = static_cast<int>(height);
+    } else if (biome == Biome::SNOW) {
+        heightVariation = 8.0f;
+        if (groundHeight < 40) {
+            height = 40.0f + heightVariation * heightNoise;
+            groundHeight = static_cast<int>(height);
+        }
+    }
+    
+    TerrainColumn column;
+    column.groundHeight = groundHeight;
+    column.biome = biome;
     
-    // Generate terrain with biomes, caves, and trees
+    // Terrain layers based on biome
+    switch (biome) {
+        case Biome::DESERT:
+            column.surfaceBlock = BlockType::SAND;
+            column.dirtBlock = BlockType::SAND;
+            break;
+        case Biome::SNOW:
+            column.surfaceBlock = BlockType::SNOW;
+            column.dirtBlock = BlockType::DIRT;
+            break;
+        case Biome::OCEAN:
+            column.surfaceBlock = BlockType::SAND;
+            column.dirtBlock = BlockType::SAND;
+            break;
+        case Biome::FOREST:
+        case Biome::GRASSLAND:
+        default:
+            column.surfaceBlock = BlockType::GRASS;
+            column.dirtBlock = BlockType::DIRT;
+            break;
+    }
+    
+    return column;
+}
+
+void World::generateTerrain(Chunk& chunk, const ChunkColumn& chunkColumn) {
+    PROFILE_SCOPE("World::generateTerrain");
+    glm::ivec3 origin = chunk.getPosition() * glm::ivec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+    
+    // Stages 1-3 a column at a time, sampled a little past the chunk's top and bottom
+    // for cave features reaching in, then cave features from that unmodified terrain
+    BlockType terrain[CHUNK_HEIGHT + 2 * CAVE_FEATURE_LENGTH];
+    BlockType blocks[CHUNK_HEIGHT];
     for (int x = 0; x < CHUNK_SIZE; x++) {
         for (int z = 0; z < CHUNK_SIZE; z++) {
-            int worldX = chunkPos.x * CHUNK_SIZE + x;
-            int worldZ = chunkPos.z * CHUNK_SIZE + z;
-            
-            // Height map with noise
-            float heightNoise = noise2D(worldX, worldZ);
-            float baseHeight = 32.0f;
-            float heightVariation = 12.0f;
-            float height = baseHeight + heightVariation * heightNoise;
-            int groundHeight = static_cast<int>(height);
-            
-            // Determine biome
-            Biome biome = determineBiome(worldX, worldZ, height);
-            
-            // Adjust height variation based on biome
-            if (biome == Biome::DESERT) {
-                heightVariation = 4.0f;
-                height = baseHeight + heightVariation * heightNoise;
-                groundHeight = static_cast<int>(height);
-            } else if (biome == Biome::OCEAN) {
-                heightVariation = 2.0f;
-                height = 26.0f + heightVariation * heightNoise; // Lower base for ocean
-                groundHeight = static_cast<int>(height);
-            } else if (biome == Biome::SNOW) {
-                heightVariation = 8.0f;
-                if (groundHeight < 40) {
-                    height = 40.0f + heightVariation * heightNoise;
-                    groundHeight = static_cast<int>(height);
-                }
-            }
-            
-            // Generate blocks
-            for (int y = 0; y < CHUNK_HEIGHT; y++) {
-                int worldY = chunkPos.y * CHUNK_HEIGHT + y;
-                
-                // Improved cave generation - less caves in ocean
-                if (biome != Biome::OCEAN) {
-                    float density = caveDensity(worldX * 0.15f, worldY * 0.15f, worldZ * 0.15f);
-                    bool isCave = density > 0.35f && worldY < groundHeight - 5 && worldY > 5;
-                    
-                    if (isCave) {
-                        chunk.setBlock(x, y, z, BlockType::AIR);
-                        continue;
-                    }
-                }
-                
-                // Terrain layers based on biome
-                BlockType surfaceBlock = BlockType::GRASS;
-                BlockType dirtBlock = BlockType::DIRT;
-                
-                switch (biome) {
-                    case Biome::DESERT:
-                        surfaceBlock = BlockType::SAND;
-                        dirtBlock = BlockType::SAND;
-                        break;
-                    case Biome::SNOW:
-                        surfaceBlock = BlockType::SNOW;
-                        dirtBlock = BlockType::DIRT;
-                        break;
-                    case Biome::OCEAN:
-                        surfaceBlock = BlockType::SAND;
-                        dirtBlock = BlockType::SAND;
-                        break;
-                    case Biome::FOREST:
-                    case Biome::GRASSLAND:
-                    default:
-                        surfaceBlock = BlockType::GRASS;
-                        dirtBlock = BlockType::DIRT;
-                        break;
-                }
-                
-                if (worldY < groundHeight - 4) {
-                    // Deep stone
-                    chunk.setBlock(x, y, z, BlockType::STONE);
-                } else if (worldY < groundHeight - 1) {
-                    // Dirt layer
-                    chunk.setBlock(x, y, z, dirtBlock);
-                } else if (worldY == groundHeight - 1) {
-                    // Top dirt layer
-                    chunk.setBlock(x, y, z, dirtBlock);
-                } else if (worldY == groundHeight) {
-                    // Surface
-                    chunk.setBlock(x, y, z, surfaceBlock);
-                } else {
-                    chunk.setBlock(x, y, z, BlockType::AIR);
-                }
-            }
-            
-            // Generate ores in stone layers (second pass)
-            for (int y = 0; y < CHUNK_HEIGHT; y++) {
-                int worldY = chunkPos.y * CHUNK_HEIGHT + y;
-                if (worldY < groundHeight - 4) { // Only in stone layers
-                    generateOre(chunk, x, y, z, worldX, worldY, worldZ);
-                }
-            }
-            
-            // Generate stalactites/stalagmites in caves (third pass)
-            for (int y = 0; y < CHUNK_HEIGHT; y++) {
-                int worldY = chunkPos.y * CHUNK_HEIGHT + y;
-                if (chunk.getBlockType(x, y, z) == BlockType::AIR && 
-                    worldY < groundHeight - 5 && worldY > 5) {
-                    generateStalactites(chunk, x, y, z, worldX, worldY, worldZ);
-                }
-            }
-            
-            // Generate trees based on biome
-            int treeChance = 0;
-            if (biome == Biome::FOREST) {
-                treeChance = 8; // ~17% chance in forests
-            } else if (biome == Biome::GRASSLAND) {
-                treeChance = 2; // ~4% chance in grasslands
-            }
-            // No trees in desert, snow, or ocean
+            int worldX = origin.x + x;
+            int worldZ = origin.z + z;
+            const TerrainColumn& column = chunkColumn.surface[x * CHUNK_SIZE + z];
             
-            if (treeChance > 0 && groundHeight < CHUNK_HEIGHT - 10) {
-                int worldY = groundHeight + 1;
-                int localY = worldY - chunkPos.y * CHUNK_HEIGHT;
-                
-                // Random tree placement
-                if (localY >= 0 && localY < CHUNK_HEIGHT &&
-                    (worldX * 7 + worldZ * 11) % 47 < treeChance) {
-                    generateTree(chunk, x, localY, z);
-                }
-            }
+            generateColumnTerrain(column, worldX, origin.y - CAVE_FEATURE_LENGTH, worldZ,
+                                  terrain, CHUNK_HEIGHT + 2 * CAVE_FEATURE_LENGTH);
+            std::copy(terrain + CAVE_FEATURE_LENGTH, terrain + CAVE_FEATURE_LENGTH + CHUNK_HEIGHT, blocks);
+            addCaveFeatures(terrain, blocks, worldX, origin.y, worldZ, column.groundHeight);
+            chunk.setColumn(x, z, blocks);
+        }
+    }
+    
+    // Trees last, so leaves can tell what they would replace. The column lists every
+    // tree reaching into it, including ones rooted in the chunks around this one.
+    for (const TreeRoot& tree : chunkColumn.trees) {
+        int top = tree.base.y + tree.height + TREE_LEAF_RADIUS;
+        if (top >= origin.y && tree.base.y < origin.y + CHUNK_HEIGHT) {
+            placeTree(chunk, tree.base - origin, tree.height);
         }
     }
 }
 
-void World::unloadDistantChunks(const glm::vec3& playerPos) {
-    glm::ivec3 playerChunk = worldToChunk(static_cast<int>(playerPos.x), 
-                                          static_cast<int>(playerPos.y), 
-                                          static_cast<int>(playerPos.z));
+void World::setRenderDistance(int chunks) {
+    chunks = std::clamp(chunks, MIN_RENDER_DISTANCE, MAX_RENDER_DISTANCE);
+    if (chunks == m_renderDistance) return;
+    
+    m_renderDistance = chunks;
+    m_unloadScanPending = true;
+    rebuildLoadOrder();
+}
+
+void World::rebuildLoadOrder() {
+    m_loadOrder.clear();
+    for (int x = -m_renderDistance; x <= m_renderDistance; x++) {
+        for (int z = -m_renderDistance; z <= m_renderDistance; z++) {
+            m_loadOrder.emplace_back(x, z);
+        }
+    }
+    
+    // Nearest first, so raising the distance fills in around the player before the edges
+    std::stable_sort(m_loadOrder.begin(), m_loadOrder.end(), [](const glm::ivec2& a, const glm::ivec2& b) {
+        return a.x * a.x + a.y * a.y < b.x * b.x + b.y * b.y;
+    });
+    m_loadCursor = 0;
+}
+
+// Lowest chunk y-level that still holds visible surface in the column
+static int getSurfaceChunkY(const ChunkColumn& column, int surfaceMargin) {
+    return floorDiv(column.minGroundY - surfaceMargin, CHUNK_HEIGHT);
+}
+
+bool World::isInLoadRange(int chunkX, int chunkY, int chunkZ) {
+    // Same columns and y-levels the loading loop in update() walks
+    if (std::abs(chunkX - m_loadCenter.x) > m_renderDistance || std::abs(chunkZ - m_loadCenter.z) > m_renderDistance) {
+        return false;
+    }
+    // Runs every frame, so it never waits on sampling: a column still being sampled
+    // counts as in range, holding its neighbours' meshes back until it is known
+    const ChunkColumn* column = findReadyColumn(chunkX, chunkZ);
+    if (!column) {
+        return true;
+    }
+    if (chunkY > floorDiv(column->maxBlockY, CHUNK_HEIGHT)) {
+        return false;
+    }
+    bool nearPlayer = chunkY >= m_loadNearRange.x && chunkY <= m_loadNearRange.y;
+    return nearPlayer || chunkY >= getSurfaceChunkY(*column, SURFACE_MARGIN);
+}
+
+bool World::hasPendingNeighbors(const Chunk& chunk) {
+    glm::ivec3 position = chunk.getPosition();
+    for (int face = 0; face < CHUNK_NEIGHBOR_COUNT; face++) {
+        if (chunk.isNeighborReady(face)) continue;
+        glm::ivec3 neighbor = position + getFaceOffset(face);
+        if (isInLoadRange(neighbor.x, neighbor.y, neighbor.z)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void World::meshAfterLoad(const ChunkKey& key) {
+    // The new chunk, and any neighbour it was the last one missing, can mesh now
+    meshIfReady(getChunk(key.x, key.y, key.z));
+    for (int face = 0; face < CHUNK_NEIGHBOR_COUNT; face++) {
+        glm::ivec3 offset = getFaceOffset(face);
+        meshIfReady(getChunk(key.x + offset.x, key.y + offset.y, key.z + offset.z));
+    }
+}
+
+void World::meshIfReady(Chunk* chunk) {
+    if (!chunk || !chunk->needsMeshUpdate() || hasPendingNeighbors(*chunk)) {
+        return;
+    }
+    auto worldQuery = [this](int x, int y, int z) { return this->getBlock(x, y, z); };
+    auto lightQuery = [this](int x, int y, int z) { return this->getLight(x, y, z); };
+    chunk->generateMesh(worldQuery, lightQuery);
+}
+
+bool World::isDistant(const ChunkKey& key, const glm::ivec3& playerChunk) {
+    // One chunk of hysteresis keeps chunks on the boundary from being dropped and reloaded
+    // as the player moves back and forth
+    int horizontalLimit = m_renderDistance + 1;
+    int dx = std::abs(key.x - playerChunk.x);
+    int dz = std::abs(key.z - playerChunk.z);
+    if (dx > horizontalLimit || dz > horizontalLimit) {
+        return true;
+    }
+    
+    // Underground chunks are only kept while the player is near them
+    const ChunkColumn* column = findReadyColumn(key.x, key.z);
+    if (column) {
+        bool nearPlayer = key.y >= m_loadNearRange.x - 1 && key.y <= m_loadNearRange.y + 1;
+        return !nearPlayer && key.y < getSurfaceChunkY(*column, SURFACE_MARGIN);
+    }
+    return false;
+}
+
+void World::unloadDistantChunks(const glm::ivec3& playerChunk) {
+    // Nothing becomes distant until the load range moves, so most frames skip the walk.
+    // The per-frame cap spreads the cost of saving and freeing chunks after the render
+    // distance is lowered; the scan repeats until a pass finishes under it.
+    if (!m_unloadScanPending) return;
+    int horizontalLimit = m_renderDistance + 1;
+    int unloaded = 0;
     
     auto it = m_chunks.begin();
-    while (it != m_chunks.end()) {
+    while (it != m_chunks.end() && unloaded < MAX_UNLOADS_PER_FRAME) {
         ChunkKey key = it->first;
-        int dx = std::abs(key.x - playerChunk.x);
-        int dy = std::abs(key.y - playerChunk.y);
-        int dz = std::abs(key.z - playerChunk.z);
-        
-        if (dx > RENDER_DISTANCE || dy > RENDER_DISTANCE || dz > RENDER_DISTANCE) {
+        if (isDistant(key, playerChunk)) {
             // Save chunk before unloading
-            saveChunk(it->second.get(), m_worldName);
+            if (m_persistenceEnabled && it->second) {
+                saveChunk(it->second.get(), m_worldName);
+            }
+            if (it->second) {
+                m_culler.remove(it->second.get());
+            }
+            unlinkChunk(key);
             
             it = m_chunks.erase(it);
+            unloaded++;
         } else {
             ++it;
         }
     }
+    m_unloadScanPending = it != m_chunks.end();
+    
+    // Finished generation that fell out of range is dropped here; running jobs still own
+    // their storage, so installFinishedChunks drops those once they are done.
+    for (auto pendingIt = m_pendingChunks.begin(); pendingIt != m_pendingChunks.end();) {
+        if (JobSystem::isDone(pendingIt->second.job) && isDistant(pendingIt->first, playerChunk)) {
+            pendingIt = m_pendingChunks.erase(pendingIt);
+        } else {
+            ++pendingIt;
+        }
+    }
+    
+    // Columns are cheap to rebuild, so they only get a little more slack than chunks.
+    // Jobs still sampling or reading one hold their own reference.
+    for (auto columnIt = m_columns.begin(); columnIt != m_columns.end();) {
+        int dx = std::abs(columnIt->first.x - playerChunk.x);
+        int dz = std::abs(columnIt->first.z - playerChunk.z);
+        if (dx > horizontalLimit + 1 || dz > horizontalLimit + 1) {
+            m_columnJobs.erase(columnIt->first);
+            columnIt = m_columns.erase(columnIt);
+        } else {
+            ++columnIt;
+        }
+    }
 }
 
 void World::update(const glm::vec3& playerPos) {
+    PROFILE_SCOPE("World::update");
     glm::ivec3 playerChunk = worldToChunk(static_cast<int>(playerPos.x), 
                                           static_cast<int>(playerPos.y), 
                                           static_cast<int>(playerPos.z));
+    int playerY = static_cast<int>(std::floor(playerPos.y));
+    glm::ivec2 nearRange(floorDiv(playerY - VERTICAL_VIEW_BLOCKS, CHUNK_HEIGHT),
+                         floorDiv(playerY + VERTICAL_VIEW_BLOCKS, CHUNK_HEIGHT));
     
-    // Load chunks around player
-    for (int x = -RENDER_DISTANCE; x <= RENDER_DISTANCE; x++) {
-        for (int y = -1; y <= 1; y++) {
-            for (int z = -RENDER_DISTANCE; z <= RENDER_DISTANCE; z++) {
-                int chunkX = playerChunk.x + x;
-                int chunkY = playerChunk.y + y;
-                int chunkZ = playerChunk.z + z;
-                
-                Chunk* chunk = getOrCreateChunk(chunkX, chunkY, chunkZ);
-                if (chunk->needsMeshUpdate()) {
-                    // Generate mesh with world block query function for cross-chunk culling
-                    auto worldQuery = [this](int x, int y, int z) { return this->getBlock(x, y, z); };
-                    chunk->generateMesh(worldQuery);
-                }
+    // Generate mesh with world block query function for cross-chunk culling
+    auto worldQuery = [this](int x, int y, int z) { return this->getBlock(x, y, z); };
+    auto lightQuery = [this](int x, int y, int z) { return this->getLight(x, y, z); };
+    
+    // Block edits and light changes re-mesh immediately, independent of the load budget.
+    // Chunks still waiting on a neighbour stay queued for the next frame.
+    for (auto it = m_dirtyChunks.begin(); it != m_dirtyChunks.end();) {
+        Chunk* chunk = getChunk(it->x, it->y, it->z);
+        if (chunk && chunk->needsMeshUpdate() && hasPendingNeighbors(*chunk)) {
+            ++it;
+            continue;
+        }
+        if (chunk) {
+            chunk->generateMesh(worldQuery, lightQuery);
+        }
+        it = m_dirtyChunks.erase(it);
+    }
+    
+    // Moving to another chunk restarts the scan, since the offsets are relative
+    if (playerChunk != m_loadCenter || nearRange != m_loadNearRange) {
+        m_loadCenter = playerChunk;
+        m_loadNearRange = nearRange;
+        m_loadCursor = 0;
+        m_unloadScanPending = true;
+    }
+    
+    // Chunks generated since last frame go in first, freeing their slots for requests
+    uint64_t deadlineNs = Profiler::nowNs() + static_cast<uint64_t>(LOAD_BUDGET_MS * 1.0e6f);
+    installFinishedChunks(deadlineNs);
+    
+    // Request missing chunks column by column, nearest-first, keeping a few generation
+    // jobs queued per worker. The scan runs on past columns still generating, but the
+    // cursor only moves over columns whose chunks are all installed.
+    size_t maxPending = static_cast<size_t>(std::max(1, JobSystem::getWorkerCount()) * PENDING_CHUNKS_PER_WORKER);
+    bool loadedSoFar = true;
+    int requested = 0;
+    for (size_t i = m_loadCursor; i < m_loadOrder.size() && m_pendingChunks.size() < maxPending; i++) {
+        // Without workers, generation runs inside requestChunk and has to share the budget
+        if (requested > 0 && Profiler::nowNs() >= deadlineNs) break;
+        
+        int chunkX = m_loadCenter.x + m_loadOrder[i].x;
+        int chunkZ = m_loadCenter.z + m_loadOrder[i].y;
+        requestColumn(chunkX, chunkZ);
+        const ChunkColumn* column = findReadyColumn(chunkX, chunkZ);
+        
+        // From just below the surface up to the highest block, plus anything near the
+        // player. Until the column is sampled only the levels near the player are known
+        // to be wanted; those are queued straight away behind the sampling job.
+        int surfaceChunkY = nearRange.x;
+        int topChunkY = nearRange.y;
+        if (column) {
+            surfaceChunkY = getSurfaceChunkY(*column, SURFACE_MARGIN);
+            topChunkY = floorDiv(column->maxBlockY, CHUNK_HEIGHT);
+        }
+        bool columnLoaded = column != nullptr;
+        for (int chunkY = std::min(surfaceChunkY, nearRange.x);
+             chunkY <= topChunkY && m_pendingChunks.size() < maxPending; chunkY++) {
+            bool nearPlayer = chunkY >= nearRange.x && chunkY <= nearRange.y;
+            if (chunkY < surfaceChunkY && !nearPlayer) continue;
+            ChunkKey key{chunkX, chunkY, chunkZ};
+            if (m_chunks.count(key)) continue;
+            
+            columnLoaded = false;
+            if (!m_pendingChunks.count(key)) {
+                requestChunk(chunkX, chunkY, chunkZ);
+                requested++;
             }
         }
+        
+        loadedSoFar = loadedSoFar && columnLoaded;
+        if (loadedSoFar) {
+            m_loadCursor = i + 1;
+        }
     }
     
     // Unload distant chunks
-    unloadDistantChunks(playerPos);
+    unloadDistantChunks(playerChunk);
 }
 
 void World::render(Shader& shader, unsigned int texture) {
+    PROFILE_SCOPE("World::render");
+    // Texture and sampler are shared by every chunk, so bind them once per frame
+    shader.use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    shader.setInt("texture1", 0);
+    Uniform<glm::vec3> offsetUniform = shader.getUniform<glm::vec3>("chunkOffset");
+    
     for (auto& pair : m_chunks) {
-        pair.second->render(shader, texture);
+        if (pair.second) {
+            pair.second->render(shader, offsetUniform);
+        }
     }
 }
 
 void World::render(Shader& shader, unsigned int texture, const Frustum& frustum) {
-    for (auto& pair : m_chunks) {
-        Chunk* chunk = pair.second.get();
-        
-        // Get chunk bounding box
-        glm::vec3 min, max;
-        chunk->getBoundingBox(min, max);
-        
-        // Only render if chunk is inside frustum
-        if (frustum.isAABBInside(min, max)) {
-            chunk->render(shader, texture);
-        }
+    PROFILE_SCOPE("World::render");
+    shader.use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    shader.setInt("texture1", 0);
+    Uniform<glm::vec3> offsetUniform = shader.getUniform<glm::vec3>("chunkOffset");
+    
+    // Only render chunks inside the frustum
+    m_culler.cull(frustum, m_visibleChunks);
+    for (Chunk* chunk : m_visibleChunks) {
+        chunk->render(shader, offsetUniform);
     }
 }
 
 std::string World::getChunkFilePath(int chunkX, int chunkY, int chunkZ, const std::string& worldName) const {
+    // Other chunk dimensions save beside the default ones; their coordinates don't match
     std::stringstream ss;
-    ss << "saves/" << worldName << "/chunks/" << chunkX << "_" << chunkY << "_" << chunkZ << ".chunk";
+    ss << "saves/" << worldName << "/chunks";
+    if (CHUNK_SIZE != 16 || CHUNK_HEIGHT != 64) {
+        ss << "_" << CHUNK_SIZE << "x" << CHUNK_HEIGHT;
+    }
+    ss << "/" << chunkX << "_" << chunkY << "_" << chunkZ << ".chunk";
     return ss.str();
 }
 
+std::vector<float> World::takeChunkLoadTimes() {
+    std::vector<float> times;
+    times.swap(m_chunkLoadTimes);
+    return times;
+}
+
 void World::saveAllChunks() const {
+    if (!m_persistenceEnabled) {
+        return;
+    }
+    
     for (const auto& pair : m_chunks) {
         saveChunk(pair.second.get(), m_worldName);
     }
@@ -533,6 +1047,8 @@ bool World::saveChunk(const Chunk* chunk, const std::string& worldName) const {
 }
 
 bool World::loadChunk(Chunk& chunk, int chunkX, int chunkY, int chunkZ, const std::string& worldName) const {
+    PROFILE_SCOPE("World::loadChunk");
+    
     // Get file path
     std::string filePath = getChunkFilePath(chunkX, chunkY, chunkZ, worldName);
     
@@ -1,16 +1,42 @@
 #pragma once
 #include "Chunk.h"
+#include "LightEngine.h"
+#include "ChunkCuller.h"
+#include "ChunkPool.h"
+#include "BiomeMap.h"
 #include "renderer/Shader.h"
+#include "core/JobSystem.h"
 #include <unordered_map>
+#include <unordered_set>
+#include <array>
 #include <glm/glm.hpp>
 #include <memory>
+#include <vector>
 
-enum class Biome {
-    GRASSLAND,
-    DESERT,
-    SNOW,
-    FOREST,
-    OCEAN
+// Surface description of one terrain column. Shared by full chunk generation and
+// the far-terrain LOD, which builds meshes straight from it without any blocks.
+struct TerrainColumn {
+    int groundHeight;       // World Y of the surface block
+    Biome biome;
+    BlockType surfaceBlock;
+    BlockType dirtBlock;
+};
+
+// A tree generation places, rooted on the terrain surface
+struct TreeRoot {
+    glm::ivec3 base;    // Lowest trunk block, world coordinates
+    int height;         // Trunk blocks; the canopy sits on top
+};
+
+// Terrain bounds of one column of chunks, used to decide which chunk y-levels are
+// worth loading. The per-block surface samples double as a cache, so every chunk
+// generated in the column reuses them instead of re-evaluating the height noise.
+struct ChunkColumn {
+    std::array<TerrainColumn, CHUNK_SIZE * CHUNK_SIZE> surface;  // Indexed x * CHUNK_SIZE + z
+    std::vector<TreeRoot> trees;    // Every tree reaching into the column, some rooted just outside
+    int minGroundY;     // Lowest surface block in the column
+    int maxGeneratedY;  // Highest block terrain or trees place; fixed once sampled
+    int maxBlockY;      // maxGeneratedY raised to cover player edits (main thread only)
 };
 
 struct ChunkKey {
@@ -42,25 +68,129 @@ public:
     Chunk* getChunk(int chunkX, int chunkY, int chunkZ);
     BlockType getBlock(int worldX, int worldY, int worldZ);
     void setBlock(int worldX, int worldY, int worldZ, BlockType type);
+    // Packed light (see packLight). Unloaded positions count as open sky above the
+    // terrain surface and dark below it; all-air chunks count as open sky.
+    uint8_t getLight(int worldX, int worldY, int worldZ);
     
     // Mark chunk as dirty when block is modified
     void markChunkDirty(int worldX, int worldY, int worldZ);
+    // Queue a loaded chunk to be remeshed; every change to a stored chunk's mesh goes through here
+    void markChunkDirty(Chunk& chunk);
+    
+    // Terrain is a pure function of position, so columns can be sampled anywhere
+    static TerrainColumn sampleTerrainColumn(int worldX, int worldZ);
+    // Biome of a column, cheap enough for gameplay and minimap queries
+    static Biome getBiome(int worldX, int worldZ) { return sampleTerrainColumn(worldX, worldZ).biome; }
+    
+    // Horizontal radius in chunks kept loaded around the player. Vertically, each column
+    // loads from just below its lowest surface to its highest block, plus the chunks near
+    // the player; empty sky is never allocated. Changes take effect
+    // incrementally: missing chunks stream in nearest-first under a per-frame time
+    // budget and chunks outside the new radius are evicted a few at a time.
+    void setRenderDistance(int chunks);
+    int getRenderDistance() const { return m_renderDistance; }
+    static constexpr int MIN_RENDER_DISTANCE = 2;
+    static constexpr int MAX_RENDER_DISTANCE = 32;
     
     // Save/Load
     void setWorldName(const std::string& worldName) { m_worldName = worldName; }
     void saveAllChunks() const;
     
+    // When disabled, chunks are always generated and never read from or written to disk
+    // (timedemo runs need a pristine, reproducible world)
+    void setPersistenceEnabled(bool enabled) { m_persistenceEnabled = enabled; }
+    bool isPersistenceEnabled() const { return m_persistenceEnabled; }
+    
+    // Optional per-chunk load latency samples (ms from request to installed chunk)
+    void setChunkLoadTracking(bool enabled) { m_trackChunkLoads = enabled; }
+    std::vector<float> takeChunkLoadTimes();
+    
 private:
-    std::unordered_map<ChunkKey, std::unique_ptr<Chunk>> m_chunks;
+    // A null entry is a loaded chunk that is entirely air: no blocks or mesh are kept for it
+    std::unordered_map<ChunkKey, ChunkPool::Handle> m_chunks;
+    // Keyed with y = 0. Shared with the generation jobs reading them, so a column can be
+    // dropped while a job is still using it.
+    std::unordered_map<ChunkKey, std::shared_ptr<ChunkColumn>> m_columns;
+    // Columns still being sampled, or sampled but not yet checked for player edits
+    std::unordered_map<ChunkKey, JobHandle> m_columnJobs;
+    
+    // Chunks being generated on the job system. Storage is taken from the pool up front
+    // and owned here until the main thread installs the finished chunk in m_chunks.
+    struct PendingChunk {
+        ChunkPool::Handle chunk;
+        JobHandle job;
+        uint64_t requestNs;
+    };
+    std::unordered_map<ChunkKey, PendingChunk> m_pendingChunks;
     std::string m_worldName;
-    static constexpr int RENDER_DISTANCE = 4;
+    bool m_persistenceEnabled;
+    bool m_trackChunkLoads;
+    std::vector<float> m_chunkLoadTimes;
+    int m_renderDistance;
+    LightEngine m_lightEngine;
+    ChunkCuller m_culler;                   // Every non-null entry of m_chunks
+    // Chunks waiting to be remeshed, by key so unloading one can't leave it dangling. Ones
+    // still waiting on a neighbour stay queued until it loads or leaves the load range.
+    std::unordered_set<ChunkKey> m_dirtyChunks;
+    std::vector<Chunk*> m_visibleChunks;    // Last cull result, reused every frame
+    
+    // Column offsets within the render distance sorted nearest-first. Every column before
+    // m_loadCursor is known to be loaded around m_loadCenter.
+    std::vector<glm::ivec2> m_loadOrder;
+    glm::ivec3 m_loadCenter;
+    glm::ivec2 m_loadNearRange;     // Chunk y-levels within VERTICAL_VIEW_BLOCKS of the player
+    size_t m_loadCursor;
+    // Set when the load range moves or a chunk lands outside it; cleared once a scan
+    // leaves nothing distant behind
+    bool m_unloadScanPending;
+    
+    static constexpr int VERTICAL_VIEW_BLOCKS = 32;     // Blocks above and below the player always loaded
+    static constexpr int SURFACE_MARGIN = 8;            // Blocks below the lowest surface kept for cliff sides
+    static constexpr float LOAD_BUDGET_MS = 4.0f;       // Time spent loading new chunks per frame
+    static constexpr int PENDING_CHUNKS_PER_WORKER = 4; // Generation jobs kept queued ahead of the workers
+    static constexpr int MAX_UNLOADS_PER_FRAME = 16;
     
     glm::ivec3 worldToChunk(int x, int y, int z) const;
     glm::ivec3 worldToBlock(int x, int y, int z) const;
     Chunk* getOrCreateChunk(int chunkX, int chunkY, int chunkZ);
-    void generateTerrain(Chunk& chunk);
-    void unloadDistantChunks(const glm::vec3& playerPos);
-    Biome determineBiome(int worldX, int worldZ, float height) const;
+    Chunk* streamChunk(int chunkX, int chunkY, int chunkZ);
+    // Adds a loaded chunk (null storage if it is all air) and wires it into the world
+    Chunk* installChunk(const ChunkKey& key, ChunkPool::Handle chunk);
+    // Queues generation of a chunk, which depends on its column's sampling job
+    void requestChunk(int chunkX, int chunkY, int chunkZ);
+    // Installs generated chunks until the frame's budget runs out; returns how many
+    int installFinishedChunks(uint64_t deadlineNs);
+    void installPendingChunk(std::unordered_map<ChunkKey, PendingChunk>::iterator it);
+    
+    // Columns are sampled on the job system. getOrCreateColumn waits for that, where
+    // requestColumn only queues it and findReadyColumn only returns finished columns.
+    ChunkColumn& getOrCreateColumn(int chunkX, int chunkZ);
+    void requestColumn(int chunkX, int chunkZ);
+    const ChunkColumn* findReadyColumn(int chunkX, int chunkZ);
+    void finishColumn(const ChunkKey& key, ChunkColumn& column);
+    static void sampleColumn(ChunkColumn& column, int chunkX, int chunkZ);
+    // Every generation stage for one chunk. Reads nothing but the column, so it runs on
+    // worker threads.
+    static void generateTerrain(Chunk& chunk, const ChunkColumn& column);
+    // Whether a chunk (loaded or still generating) is far enough away to be dropped
+    bool isDistant(const ChunkKey& key, const glm::ivec3& playerChunk);
+    void unloadDistantChunks(const glm::ivec3& playerChunk);
+    
+    // Neighbour links: wire a key's entry (new, or an all-air entry given storage) to the
+    // loaded chunks around it, and detach it again before the entry is erased
+    void linkChunk(const ChunkKey& key);
+    void unlinkChunk(const ChunkKey& key);
+    // Whether the streaming scan around the player will load this position. Never blocks;
+    // positions in a column that hasn't been sampled yet count as in range.
+    bool isInLoadRange(int chunkX, int chunkY, int chunkZ);
+    // A chunk waits to be meshed while a neighbour that is going to load hasn't yet, so
+    // its border faces are built once against the real blocks
+    bool hasPendingNeighbors(const Chunk& chunk);
+    void meshIfReady(Chunk* chunk);
+    // Meshes a newly loaded chunk and the neighbours that were waiting on it
+    void meshAfterLoad(const ChunkKey& key);
+    void rebuildLoadOrder();
+    static Biome determineBiome(int worldX, int worldZ, float height);
     
     // Save/Load system
     bool saveChunk(const Chunk* chunk, const std::string& worldName) const;
@@ -6,7 +6,6 @@
 #include <sstream>
 #include <algorithm>
 #include <ctime>
-#include <glm/glm.hpp>
 
 WorldManager& WorldManager::getInstance() {
     static WorldManager instance;
@@ -76,6 +75,7 @@ bool WorldManager::createNewWorld(const std::string& worldName, std::string& wor
     
     worldPath = basePath;
     m_currentWorld = sanitized;
+    invalidateCatalogue();
     
     return true;
 }
@@ -88,6 +88,7 @@ bool WorldManager::deleteWorld(const std::string& worldName) {
     
     try {
         std::filesystem::remove_all(worldPath);
+        invalidateCatalogue();
         if (m_currentWorld == worldName) {
             m_currentWorld = "";
         }
@@ -102,30 +103,100 @@ bool WorldManager::worldExists(const std::string& worldName) const {
     return std::filesystem::exists(worldPath);
 }
 
-std::vector<WorldInfo> WorldManager::getAvailableWorlds() const {
-    std::vector<WorldInfo> worlds;
-    std::string worldsDir = getWorldsDirectory();
+void WorldManager::rebuildCatalogue() {
+    // Entries whose world.info hasn't changed keep their parsed info
+    std::vector<CatalogueEntry> previous;
+    previous.swap(m_catalogue);
+    std::sort(previous.begin(), previous.end(),
+        [](const CatalogueEntry& a, const CatalogueEntry& b) { return a.folderName < b.folderName; });
     
-    if (!std::filesystem::exists(worldsDir)) {
-        return worlds;
+    m_catalogueValid = true;
+    m_catalogueTimer = 0.0f;
+    
+    std::error_code ec;
+    std::string worldsDir = getWorldsDirectory();
+    m_savesTime = std::filesystem::last_write_time(worldsDir, ec);
+    if (ec) {
+        return;
     }
     
-    for (const auto& entry : std::filesystem::directory_iterator(worldsDir)) {
-        if (entry.is_directory()) {
-            WorldInfo info = loadWorldInfo(entry.path().string());
-            if (!info.name.empty()) {
-                worlds.push_back(info);
-            }
+    // Listing plus one stat per world; nothing is parsed here
+    for (const auto& entry : std::filesystem::directory_iterator(worldsDir, ec)) {
+        if (!entry.is_directory(ec)) continue;
+        
+        CatalogueEntry world;
+        world.folderName = entry.path().filename().string();
+        world.infoTime = std::filesystem::last_write_time(entry.path() / "world.info", ec);
+        if (ec) continue;  // Not a world folder
+        
+        auto it = std::lower_bound(previous.begin(), previous.end(), world.folderName,
+            [](const CatalogueEntry& e, const std::string& name) { return e.folderName < name; });
+        if (it != previous.end() && it->folderName == world.folderName && it->infoTime == world.infoTime) {
+            world = std::move(*it);
         }
+        m_catalogue.push_back(std::move(world));
     }
     
-    // Sort by last played time (most recent first)
-    std::sort(worlds.begin(), worlds.end(),
-        [](const WorldInfo& a, const WorldInfo& b) {
-            return a.lastPlayedTime > b.lastPlayedTime;
+    // Most recently played first; playing a world rewrites its world.info, so the file
+    // time orders like lastPlayedTime without reading any file
+    std::sort(m_catalogue.begin(), m_catalogue.end(),
+        [](const CatalogueEntry& a, const CatalogueEntry& b) {
+            if (a.infoTime != b.infoTime) return a.infoTime > b.infoTime;
+            return a.folderName < b.folderName;
         });
+}
+
+size_t WorldManager::getWorldCount() {
+    if (!m_catalogueValid) {
+        rebuildCatalogue();
+    }
+    return m_catalogue.size();
+}
+
+const WorldInfo& WorldManager::getWorld(size_t index) {
+    if (!m_catalogueValid) {
+        rebuildCatalogue();
+    }
     
-    return worlds;
+    CatalogueEntry& entry = m_catalogue[index];
+    if (!entry.loaded) {
+        entry.info = loadWorldInfo(getWorldsDirectory() + entry.folderName);
+        if (entry.info.name.empty()) {
+            entry.info.name = entry.folderName;
+        }
+        entry.info.folderName = entry.folderName;
+        entry.loaded = true;
+    }
+    return entry.info;
+}
+
+void WorldManager::updateCatalogue(float deltaTime) {
+    if (!m_catalogueValid) {
+        return;  // Rebuilt on next access anyway
+    }
+    
+    m_catalogueTimer += deltaTime;
+    if (m_catalogueTimer < CATALOGUE_CHECK_INTERVAL) {
+        return;
+    }
+    m_catalogueTimer = 0.0f;
+    
+    // Worlds added or removed by something else change the saves/ folder itself
+    std::error_code ec;
+    if (std::filesystem::last_write_time(getWorldsDirectory(), ec) != m_savesTime) {
+        m_catalogueValid = false;
+        return;
+    }
+    
+    // Only parsed entries can be stale; the rest are read when first asked for
+    for (const CatalogueEntry& entry : m_catalogue) {
+        if (!entry.loaded) continue;
+        auto infoTime = std::filesystem::last_write_time(getWorldsDirectory() + entry.folderName + "/world.info", ec);
+        if (ec || infoTime != entry.infoTime) {
+            m_catalogueValid = false;
+            return;
+        }
+    }
 }
 
 WorldInfo WorldManager::getWorldInfo(const std::string& worldName) const {
@@ -135,6 +206,7 @@ WorldInfo WorldManager::getWorldInfo(const std::string& worldName) const {
 
 bool WorldManager::updateWorldInfo(const std::string& worldName, const WorldInfo& info) {
     std::string worldPath = getWorldsDirectory() + worldName;
+    invalidateCatalogue();
     return saveWorldInfo(worldPath, info);
 }
 
@@ -1,4 +1,6 @@
 #pragma once
+#include <glm/glm.hpp>
+#include <filesystem>
 #include <string>
 #include <vector>
 #include <ctime>
@@ -23,8 +25,15 @@ public:
     bool deleteWorld(const std::string& worldName);
     bool worldExists(const std::string& worldName) const;
     
+    // World catalogue: the saved worlds, most recently played first. Built on first use
+    // and kept in memory; only the world.info of entries actually asked for is parsed.
+    size_t getWorldCount();
+    const WorldInfo& getWorld(size_t index);
+    // Cheap change check on a slow timer (a stat of saves/ plus the parsed entries)
+    void updateCatalogue(float deltaTime);
+    void invalidateCatalogue() { m_catalogueValid = false; }
+    
     // World info
-    std::vector<WorldInfo> getAvailableWorlds() const;
     WorldInfo getWorldInfo(const std::string& worldName) const;
     bool updateWorldInfo(const std::string& worldName, const WorldInfo& info);
     
@@ -40,7 +49,8 @@ public:
     bool isAutoSaveEnabled() const { return m_autoSaveEnabled; }
     
 private:
-    WorldManager() : m_currentWorld(""), m_autoSaveEnabled(true), m_autoSaveTimer(0.0f) {}
+    WorldManager() : m_currentWorld(""), m_autoSaveEnabled(true), m_autoSaveTimer(0.0f),
+                     m_catalogueValid(false), m_catalogueTimer(0.0f) {}
     ~WorldManager() = default;
     WorldManager(const WorldManager&) = delete;
     WorldManager& operator=(const WorldManager&) = delete;
@@ -50,6 +60,21 @@ private:
     float m_autoSaveTimer;
     static constexpr float AUTO_SAVE_INTERVAL = 60.0f; // 1 minute
     
+    struct CatalogueEntry {
+        std::string folderName;
+        std::filesystem::file_time_type infoTime;  // world.info mtime; rewritten when the world is played
+        bool loaded = false;                       // info parsed from world.info yet
+        WorldInfo info;
+    };
+    
+    std::vector<CatalogueEntry> m_catalogue;
+    bool m_catalogueValid;
+    std::filesystem::file_time_type m_savesTime;   // saves/ mtime; changes when worlds come or go
+    float m_catalogueTimer;
+    static constexpr float CATALOGUE_CHECK_INTERVAL = 2.0f;
+    
+    void rebuildCatalogue();
+    
     std::string getWorldsDirectory() const;
     std::string sanitizeWorldName(const std::string& name) const;
     WorldInfo loadWorldInfo(const std::string& worldPath) const;
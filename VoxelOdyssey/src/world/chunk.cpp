@@ -1,20 +1,105 @@
 #include "Chunk.h"
 #include "renderer/Shader.h"
 #include "Block.h"
+#include "core/Profiler.h"
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <cstdint>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static_assert(CHUNK_HEIGHT <= 64, "The mesher keeps one column of blocks per 64-bit word");
+
+using ColumnMask = uint64_t;
+constexpr ColumnMask COLUMN_MASK = CHUNK_HEIGHT == 64 ? ~ColumnMask(0) : (ColumnMask(1) << CHUNK_HEIGHT) - 1;
+
+static int countTrailingZeros(ColumnMask value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+// Offset to the neighbour each face looks at: 0=front, 1=back, 2=top, 3=bottom, 4=right, 5=left
+static const glm::ivec3 FACE_DIRECTIONS[BLOCK_FACE_COUNT] = {
+    {0, 0, 1}, {0, 0, -1}, {0, 1, 0}, {0, -1, 0}, {1, 0, 0}, {-1, 0, 0}
+};
+
+glm::ivec3 getFaceOffset(int face) {
+    return FACE_DIRECTIONS[face];
+}
+
+int getNeighborFace(const glm::ivec3& offset) {
+    for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+        if (offset == FACE_DIRECTIONS[face]) return face;
+    }
+    return -1;
+}
+
+// Saved chunks keep their blocks in x, y, z order whatever the storage layout
+static int getSavedBlockIndex(int x, int y, int z) {
+    return (x * CHUNK_HEIGHT + y) * CHUNK_SIZE + z;
+}
+
+// Opacity of a chunk plus a one-block border, one 64-bit word per (x, z) column with bit y
+// set for an opaque block. Faces and AO come from shifts and lookups on these words
+// instead of a world query per voxel.
+struct ChunkOpacity {
+    static constexpr int SIZE = CHUNK_SIZE + 2;
+    
+    ColumnMask columns[SIZE][SIZE];  // Indexed [x + 1][z + 1]
+    bool above[SIZE][SIZE];          // Layer y = CHUNK_HEIGHT, from the chunk above
+    bool below[SIZE][SIZE];          // Layer y = -1, from the chunk below
+    ColumnMask transparent[CHUNK_SIZE][CHUNK_SIZE];  // Non-air blocks of this chunk that aren't opaque
+    
+    ColumnMask column(int x, int z) const { return columns[x + 1][z + 1]; }
+    
+    bool isOpaque(int x, int y, int z) const {
+        if (y < 0) return below[x + 1][z + 1];
+        if (y >= CHUNK_HEIGHT) return above[x + 1][z + 1];
+        return (columns[x + 1][z + 1] >> y) & 1;
+    }
+};
+
 Chunk::Chunk(glm::ivec3 position) 
-    : m_position(position), m_needsMeshUpdate(true) {
-    // Initialize all blocks to air
-    for (int x = 0; x < CHUNK_SIZE; x++) {
-        for (int y = 0; y < CHUNK_HEIGHT; y++) {
-            for (int z = 0; z < CHUNK_SIZE; z++) {
-                m_blocks[x][y][z].type = BlockType::AIR;
-            }
-        }
+    : m_position(position), m_needsMeshUpdate(true), m_cullSlot(-1), m_neighborReady(0),
+      m_nonAirCount(0), m_opaqueCount(0) {
+    m_neighbors.fill(nullptr);
+    fillAir();
+    m_light.fill(0);
+}
+
+void Chunk::recycle(glm::ivec3 position) {
+    m_position = position;
+    m_needsMeshUpdate = true;
+    m_cullSlot = -1;
+    m_neighbors.fill(nullptr);
+    m_neighborReady = 0;
+    m_light.fill(0);
+    // Drops the old geometry but keeps the GL buffers
+    m_mesh.updateMesh(MeshData());
+}
+
+void Chunk::clearBlocks() {
+    if (m_nonAirCount == 0) {
+        return;
     }
+    fillAir();
+    m_needsMeshUpdate = true;
+}
+
+void Chunk::fillAir() {
+    m_blocks.fill(Block{BlockType::AIR});
+    for (auto& layer : m_nonAirRows) layer.fill(0);
+    for (auto& layer : m_opaqueRows) layer.fill(0);
+    m_layerCounts.fill(0);
+    m_nonAirCount = 0;
+    m_opaqueCount = 0;
 }
 
 Block& Chunk::getBlock(int x, int y, int z) {
@@ -23,7 +108,7 @@ Block& Chunk::getBlock(int x, int y, int z) {
         airBlock.type = BlockType::AIR;
         return airBlock;
     }
-    return m_blocks[x][y][z];
+    return m_blocks[voxelIndex(x, y, z)];
 }
 
 const Block& Chunk::getBlock(int x, int y, int z) const {
@@ -31,7 +116,7 @@ const Block& Chunk::getBlock(int x, int y, int z) const {
         static const Block airBlock = {BlockType::AIR};
         return airBlock;
     }
-    return m_blocks[x][y][z];
+    return m_blocks[voxelIndex(x, y, z)];
 }
 
 BlockType Chunk::getBlockType(int x, int y, int z) const {
@@ -42,17 +127,99 @@ void Chunk::setBlock(int x, int y, int z, BlockType type) {
     if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_HEIGHT || z < 0 || z >= CHUNK_SIZE) {
         return;
     }
-    m_blocks[x][y][z].type = type;
+    writeBlock(x, y, z, type);
+}
+
+void Chunk::setColumn(int x, int z, const BlockType* types) {
+    if (x < 0 || x >= CHUNK_SIZE || z < 0 || z >= CHUNK_SIZE) {
+        return;
+    }
+    for (int y = 0; y < CHUNK_HEIGHT; y++) {
+        writeBlock(x, y, z, types[y]);
+    }
+}
+
+void Chunk::writeBlock(int x, int y, int z, BlockType type) {
+    Block& block = m_blocks[voxelIndex(x, y, z)];
+    BlockType oldType = block.type;
+    if (oldType == type) {
+        return;
+    }
+    block.type = type;
     m_needsMeshUpdate = true;
+    
+    RowMask bit = RowMask(1) << z;
+    bool wasNonAir = oldType != BlockType::AIR;
+    bool isNonAir = type != BlockType::AIR;
+    if (wasNonAir != isNonAir) {
+        m_nonAirRows[y][x] ^= bit;
+        m_layerCounts[y] += isNonAir ? 1 : -1;
+        m_nonAirCount += isNonAir ? 1 : -1;
+    }
+    if (isOpaque(oldType) != isOpaque(type)) {
+        m_opaqueRows[y][x] ^= bit;
+        m_opaqueCount += isOpaque(type) ? 1 : -1;
+    }
+}
+
+void Chunk::rebuildOccupancy() {
+    for (auto& layer : m_nonAirRows) layer.fill(0);
+    for (auto& layer : m_opaqueRows) layer.fill(0);
+    m_layerCounts.fill(0);
+    m_nonAirCount = 0;
+    m_opaqueCount = 0;
+    
+    ChunkVoxelLayout::forEach([this](int x, int y, int z, int index) {
+        BlockType type = m_blocks[index].type;
+        if (type != BlockType::AIR) {
+            m_nonAirRows[y][x] |= RowMask(1) << z;
+            m_layerCounts[y]++;
+            m_nonAirCount++;
+        }
+        if (isOpaque(type)) {
+            m_opaqueRows[y][x] |= RowMask(1) << z;
+            m_opaqueCount++;
+        }
+    });
+}
+
+void Chunk::setNeighbor(int face, Chunk* neighbor, bool ready) {
+    m_neighbors[face] = neighbor;
+    m_neighborReady = ready ? (m_neighborReady | (1 << face)) : (m_neighborReady & ~(1 << face));
+}
+
+bool Chunk::resolveNeighbor(glm::ivec3& pos, const Chunk*& owner) const {
+    const glm::ivec3 size(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+    const Chunk* chunk = this;
+    for (int axis = 0; axis < 3; axis++) {
+        if (pos[axis] >= 0 && pos[axis] < size[axis]) continue;
+        
+        // Faces along axis a are 4 - 2a (positive) and 5 - 2a (negative)
+        int face = pos[axis] < 0 ? 5 - 2 * axis : 4 - 2 * axis;
+        if (!chunk || !chunk->isNeighborReady(face)) {
+            return false;
+        }
+        chunk = chunk->m_neighbors[face];
+        pos[axis] += pos[axis] < 0 ? size[axis] : -size[axis];
+    }
+    owner = chunk;
+    return true;
 }
 
 BlockType Chunk::getNeighborBlockType(int x, int y, int z, 
-                                      std::function<BlockType(int, int, int)> worldBlockQuery) const {
+                                      const std::function<BlockType(int, int, int)>& worldBlockQuery) const {
     // Check if neighbor is within this chunk
     if (x >= 0 && x < CHUNK_SIZE && y >= 0 && y < CHUNK_HEIGHT && z >= 0 && z < CHUNK_SIZE) {
         return getBlockType(x, y, z);
     }
     
+    // Loaded neighbours are reached through the links
+    glm::ivec3 pos(x, y, z);
+    const Chunk* owner = nullptr;
+    if (resolveNeighbor(pos, owner)) {
+        return owner ? owner->getBlockType(pos.x, pos.y, pos.z) : BlockType::AIR;
+    }
+    
     // Neighbor is in adjacent chunk - use world query if available
     if (worldBlockQuery) {
         int worldX = m_position.x * CHUNK_SIZE + x;
@@ -65,29 +232,45 @@ BlockType Chunk::getNeighborBlockType(int x, int y, int z,
     return BlockType::AIR;
 }
 
-float Chunk::calculateAO(int x, int y, int z, int dx, int dy, int dz,
-                         std::function<BlockType(int, int, int)> worldBlockQuery) const {
+uint8_t Chunk::getNeighborLight(int x, int y, int z,
+                                const std::function<uint8_t(int, int, int)>& worldLightQuery) const {
+    if (x >= 0 && x < CHUNK_SIZE && y >= 0 && y < CHUNK_HEIGHT && z >= 0 && z < CHUNK_SIZE) {
+        return getLight(x, y, z);
+    }
+    
+    // All-air neighbours hold nothing that could block the sky
+    glm::ivec3 pos(x, y, z);
+    const Chunk* owner = nullptr;
+    if (resolveNeighbor(pos, owner)) {
+        return owner ? owner->getLight(pos.x, pos.y, pos.z) : packLight(MAX_LIGHT, 0);
+    }
+    
+    if (worldLightQuery) {
+        return worldLightQuery(m_position.x * CHUNK_SIZE + x,
+                               m_position.y * CHUNK_HEIGHT + y,
+                               m_position.z * CHUNK_SIZE + z);
+    }
+    return packLight(MAX_LIGHT, 0);
+}
+
+float Chunk::calculateAO(int x, int y, int z, int dx, int dy, int dz, const ChunkOpacity& opacity) const {
     // Calculate AO for a corner by checking the 3 adjacent blocks
     // dx, dy, dz indicate which corner (e.g., 1,1,1 for top-front-right corner)
     
     int solidCount = 0;
     
-    // Check the 3 blocks that share this corner
+    // Check the 3 blocks that share this corner (only opaque blocks cast AO)
     // Block in X direction
-    BlockType blockX = getNeighborBlockType(x + dx, y, z, worldBlockQuery);
-    if (blockX != BlockType::AIR) solidCount++;
+    if (opacity.isOpaque(x + dx, y, z)) solidCount++;
     
     // Block in Y direction
-    BlockType blockY = getNeighborBlockType(x, y + dy, z, worldBlockQuery);
-    if (blockY != BlockType::AIR) solidCount++;
+    if (opacity.isOpaque(x, y + dy, z)) solidCount++;
     
     // Block in Z direction
-    BlockType blockZ = getNeighborBlockType(x, y, z + dz, worldBlockQuery);
-    if (blockZ != BlockType::AIR) solidCount++;
+    if (opacity.isOpaque(x, y, z + dz)) solidCount++;
     
     // Also check the diagonal block (corner block)
-    BlockType blockDiag = getNeighborBlockType(x + dx, y + dy, z + dz, worldBlockQuery);
-    if (blockDiag != BlockType::AIR) {
+    if (opacity.isOpaque(x + dx, y + dy, z + dz)) {
         // If diagonal is solid, it contributes more darkness
         solidCount += 2;
     }
@@ -101,9 +284,8 @@ float Chunk::calculateAO(int x, int y, int z, int dx, int dy, int dz,
     return 0.4f; // 4+ solids
 }
 
-void Chunk::addFace(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
-                    glm::vec3 pos, int face, BlockType type,
-                    std::function<BlockType(int, int, int)> worldBlockQuery) {
+void Chunk::addFace(MeshData& mesh, glm::vec3 pos, int face, BlockType type, uint8_t light,
+                    const ChunkOpacity& opacity) {
     // Face definitions: 0=front, 1=back, 2=top, 3=bottom, 4=right, 5=left
     glm::vec3 normal;
     glm::vec3 v0, v1, v2, v3;
@@ -192,102 +374,199 @@ void Chunk::addFace(std::vector<Vertex>& vertices, std::vector<unsigned int>& in
     // Calculate AO for each vertex based on face and corner position
     switch (face) {
         case 0: // Front (Z+)
-            ao0 = calculateAO(blockX, blockY, blockZ, -1, -1, 1, worldBlockQuery); // Bottom-left
-            ao1 = calculateAO(blockX, blockY, blockZ, 1, -1, 1, worldBlockQuery);  // Bottom-right
-            ao2 = calculateAO(blockX, blockY, blockZ, 1, 1, 1, worldBlockQuery);    // Top-right
-            ao3 = calculateAO(blockX, blockY, blockZ, -1, 1, 1, worldBlockQuery);    // Top-left
+            ao0 = calculateAO(blockX, blockY, blockZ, -1, -1, 1, opacity); // Bottom-left
+            ao1 = calculateAO(blockX, blockY, blockZ, 1, -1, 1, opacity);  // Bottom-right
+            ao2 = calculateAO(blockX, blockY, blockZ, 1, 1, 1, opacity);    // Top-right
+            ao3 = calculateAO(blockX, blockY, blockZ, -1, 1, 1, opacity);    // Top-left
             break;
         case 1: // Back (Z-)
-            ao0 = calculateAO(blockX, blockY, blockZ, 1, -1, -1, worldBlockQuery);
-            ao1 = calculateAO(blockX, blockY, blockZ, -1, -1, -1, worldBlockQuery);
-            ao2 = calculateAO(blockX, blockY, blockZ, -1, 1, -1, worldBlockQuery);
-            ao3 = calculateAO(blockX, blockY, blockZ, 1, 1, -1, worldBlockQuery);
+            ao0 = calculateAO(blockX, blockY, blockZ, 1, -1, -1, opacity);
+            ao1 = calculateAO(blockX, blockY, blockZ, -1, -1, -1, opacity);
+            ao2 = calculateAO(blockX, blockY, blockZ, -1, 1, -1, opacity);
+            ao3 = calculateAO(blockX, blockY, blockZ, 1, 1, -1, opacity);
             break;
         case 2: // Top (Y+)
-            ao0 = calculateAO(blockX, blockY, blockZ, -1, 1, -1, worldBlockQuery);
-            ao1 = calculateAO(blockX, blockY, blockZ, -1, 1, 1, worldBlockQuery);
-            ao2 = calculateAO(blockX, blockY, blockZ, 1, 1, 1, worldBlockQuery);
-            ao3 = calculateAO(blockX, blockY, blockZ, 1, 1, -1, worldBlockQuery);
+            ao0 = calculateAO(blockX, blockY, blockZ, -1, 1, -1, opacity);
+            ao1 = calculateAO(blockX, blockY, blockZ, -1, 1, 1, opacity);
+            ao2 = calculateAO(blockX, blockY, blockZ, 1, 1, 1, opacity);
+            ao3 = calculateAO(blockX, blockY, blockZ, 1, 1, -1, opacity);
             break;
         case 3: // Bottom (Y-)
-            ao0 = calculateAO(blockX, blockY, blockZ, -1, -1, 1, worldBlockQuery);
-            ao1 = calculateAO(blockX, blockY, blockZ, -1, -1, -1, worldBlockQuery);
-            ao2 = calculateAO(blockX, blockY, blockZ, 1, -1, -1, worldBlockQuery);
-            ao3 = calculateAO(blockX, blockY, blockZ, 1, -1, 1, worldBlockQuery);
+            ao0 = calculateAO(blockX, blockY, blockZ, -1, -1, 1, opacity);
+            ao1 = calculateAO(blockX, blockY, blockZ, -1, -1, -1, opacity);
+            ao2 = calculateAO(blockX, blockY, blockZ, 1, -1, -1, opacity);
+            ao3 = calculateAO(blockX, blockY, blockZ, 1, -1, 1, opacity);
             break;
         case 4: // Right (X+)
-            ao0 = calculateAO(blockX, blockY, blockZ, 1, -1, 1, worldBlockQuery);
-            ao1 = calculateAO(blockX, blockY, blockZ, 1, -1, -1, worldBlockQuery);
-            ao2 = calculateAO(blockX, blockY, blockZ, 1, 1, -1, worldBlockQuery);
-            ao3 = calculateAO(blockX, blockY, blockZ, 1, 1, 1, worldBlockQuery);
+            ao0 = calculateAO(blockX, blockY, blockZ, 1, -1, 1, opacity);
+            ao1 = calculateAO(blockX, blockY, blockZ, 1, -1, -1, opacity);
+            ao2 = calculateAO(blockX, blockY, blockZ, 1, 1, -1, opacity);
+            ao3 = calculateAO(blockX, blockY, blockZ, 1, 1, 1, opacity);
             break;
         case 5: // Left (X-)
-            ao0 = calculateAO(blockX, blockY, blockZ, -1, -1, -1, worldBlockQuery);
-            ao1 = calculateAO(blockX, blockY, blockZ, -1, -1, 1, worldBlockQuery);
-            ao2 = calculateAO(blockX, blockY, blockZ, -1, 1, 1, worldBlockQuery);
-            ao3 = calculateAO(blockX, blockY, blockZ, -1, 1, -1, worldBlockQuery);
+            ao0 = calculateAO(blockX, blockY, blockZ, -1, -1, -1, opacity);
+            ao1 = calculateAO(blockX, blockY, blockZ, -1, -1, 1, opacity);
+            ao2 = calculateAO(blockX, blockY, blockZ, -1, 1, 1, opacity);
+            ao3 = calculateAO(blockX, blockY, blockZ, -1, 1, -1, opacity);
             break;
     }
     
-    unsigned int baseIndex = vertices.size();
+    glm::vec2 faceLight(getSkyLight(light) / float(MAX_LIGHT), getBlockLight(light) / float(MAX_LIGHT));
+    
+    // Indices come from the shared quad index buffer (see Mesh)
+    mesh.vertices.push_back({v0, normal, uv0, ao0, faceLight});
+    mesh.vertices.push_back({v1, normal, uv1, ao1, faceLight});
+    mesh.vertices.push_back({v2, normal, uv2, ao2, faceLight});
+    mesh.vertices.push_back({v3, normal, uv3, ao3, faceLight});
+}
+
+void Chunk::buildOpacity(ChunkOpacity& opacity,
+                         const std::function<BlockType(int, int, int)>& worldBlockQuery) const {
+    ColumnMask nonAir[CHUNK_SIZE][CHUNK_SIZE] = {};
+    for (int x = 0; x < ChunkOpacity::SIZE; x++) {
+        for (int z = 0; z < ChunkOpacity::SIZE; z++) {
+            opacity.columns[x][z] = 0;
+            opacity.above[x][z] = false;
+            opacity.below[x][z] = false;
+        }
+    }
     
-    vertices.push_back({v0, normal, uv0, ao0});
-    vertices.push_back({v1, normal, uv1, ao1});
-    vertices.push_back({v2, normal, uv2, ao2});
-    vertices.push_back({v3, normal, uv3, ao3});
+    // Transpose the per-layer occupancy rows into per-column words
+    for (int y = 0; y < CHUNK_HEIGHT; y++) {
+        if (m_layerCounts[y] == 0) continue;
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            RowMask nonAirRow = m_nonAirRows[y][x];
+            RowMask opaqueRow = m_opaqueRows[y][x];
+            for (int z = 0; z < CHUNK_SIZE; z++) {
+                RowMask bit = RowMask(1) << z;
+                if (nonAirRow & bit) nonAir[x][z] |= ColumnMask(1) << y;
+                if (opaqueRow & bit) opacity.columns[x + 1][z + 1] |= ColumnMask(1) << y;
+            }
+        }
+    }
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            opacity.transparent[x][z] = nonAir[x][z] & ~opacity.columns[x + 1][z + 1];
+        }
+    }
     
-    // Two triangles per face
-    indices.push_back(baseIndex);
-    indices.push_back(baseIndex + 1);
-    indices.push_back(baseIndex + 2);
-    indices.push_back(baseIndex);
-    indices.push_back(baseIndex + 2);
-    indices.push_back(baseIndex + 3);
+    // Border cells only matter next to blocks of this chunk (face tests reach one block
+    // out, AO one block diagonally), so only those are fetched from the neighbours
+    for (int px = 0; px < ChunkOpacity::SIZE; px++) {
+        for (int pz = 0; pz < ChunkOpacity::SIZE; pz++) {
+            ColumnMask nearby = 0;
+            for (int x = std::max(px - 2, 0); x <= std::min(px, CHUNK_SIZE - 1); x++) {
+                for (int z = std::max(pz - 2, 0); z <= std::min(pz, CHUNK_SIZE - 1); z++) {
+                    nearby |= nonAir[x][z];
+                }
+            }
+            if (nearby == 0) continue;
+            
+            int x = px - 1;
+            int z = pz - 1;
+            if (nearby & (ColumnMask(1) << (CHUNK_HEIGHT - 1))) {
+                opacity.above[px][pz] = ::isOpaque(getNeighborBlockType(x, CHUNK_HEIGHT, z, worldBlockQuery));
+            }
+            if (nearby & 1) {
+                opacity.below[px][pz] = ::isOpaque(getNeighborBlockType(x, -1, z, worldBlockQuery));
+            }
+            
+            bool border = px == 0 || pz == 0 || px == ChunkOpacity::SIZE - 1 || pz == ChunkOpacity::SIZE - 1;
+            if (!border) continue;
+            
+            // The whole border column lies in one neighbour, so resolve it once
+            glm::ivec3 local(x, 0, z);
+            const Chunk* owner = nullptr;
+            bool linked = resolveNeighbor(local, owner);
+            
+            ColumnMask needed = (nearby | (nearby << 1) | (nearby >> 1)) & COLUMN_MASK;
+            while (needed) {
+                int y = countTrailingZeros(needed);
+                needed &= needed - 1;
+                BlockType type = !linked ? getNeighborBlockType(x, y, z, worldBlockQuery)
+                                         : (owner ? owner->getBlockType(local.x, y, local.z) : BlockType::AIR);
+                if (::isOpaque(type)) {
+                    opacity.columns[px][pz] |= ColumnMask(1) << y;
+                }
+            }
+        }
+    }
 }
 
-void Chunk::generateMesh(std::function<BlockType(int, int, int)> worldBlockQuery) {
+void Chunk::generateMesh(const std::function<BlockType(int, int, int)>& worldBlockQuery,
+                         const std::function<uint8_t(int, int, int)>& worldLightQuery) {
     if (!m_needsMeshUpdate) {
         return;
     }
     
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
+    PROFILE_SCOPE("Chunk::generateMesh");
+    // Reused across rebuilds on this thread, so once it has grown to the largest mesh
+    // seen, remeshing doesn't allocate. A rebuild mostly ends up close to the previous
+    // mesh, which sizes the first use.
+    static thread_local MeshData scratch;
+    scratch.clear();
+    scratch.reserveQuads(m_mesh.getVertexCount() / 4);
     
-    for (int x = 0; x < CHUNK_SIZE; x++) {
-        for (int y = 0; y < CHUNK_HEIGHT; y++) {
+    if (m_nonAirCount > 0) {
+        ChunkOpacity opacity;
+        buildOpacity(opacity, worldBlockQuery);
+        
+        for (int x = 0; x < CHUNK_SIZE; x++) {
             for (int z = 0; z < CHUNK_SIZE; z++) {
-                BlockType type = getBlockType(x, y, z);
-                if (type == BlockType::AIR) {
-                    continue;
-                }
+                ColumnMask column = opacity.column(x, z);
                 
-                glm::vec3 blockPos(x, y, z);
-                
-                // Check each face and add if visible (using cross-chunk queries)
-                if (getNeighborBlockType(x, y, z + 1, worldBlockQuery) == BlockType::AIR) {
-                    addFace(vertices, indices, blockPos, 0, type, worldBlockQuery); // Front
-                }
-                if (getNeighborBlockType(x, y, z - 1, worldBlockQuery) == BlockType::AIR) {
-                    addFace(vertices, indices, blockPos, 1, type, worldBlockQuery); // Back
-                }
-                if (getNeighborBlockType(x, y + 1, z, worldBlockQuery) == BlockType::AIR) {
-                    addFace(vertices, indices, blockPos, 2, type, worldBlockQuery); // Top
+                // An opaque block shows a face wherever its neighbour isn't opaque. All six
+                // directions for the whole column at once: Y via shifts, X/Z via the
+                // neighbouring columns.
+                if (column) {
+                    ColumnMask up = (column >> 1) |
+                                    (ColumnMask(opacity.above[x + 1][z + 1]) << (CHUNK_HEIGHT - 1));
+                    ColumnMask down = (column << 1) | ColumnMask(opacity.below[x + 1][z + 1]);
+                    ColumnMask faces[BLOCK_FACE_COUNT] = {
+                        column & ~opacity.column(x, z + 1),      // Front
+                        column & ~opacity.column(x, z - 1),      // Back
+                        column & ~up,                            // Top
+                        column & ~down & COLUMN_MASK,            // Bottom
+                        column & ~opacity.column(x + 1, z),      // Right
+                        column & ~opacity.column(x - 1, z),      // Left
+                    };
+                    
+                    // Each face takes the light of the (non-opaque) block in front of it
+                    for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+                        ColumnMask visible = faces[face];
+                        glm::ivec3 dir = FACE_DIRECTIONS[face];
+                        while (visible) {
+                            int y = countTrailingZeros(visible);
+                            visible &= visible - 1;
+                            uint8_t light = getNeighborLight(x + dir.x, y + dir.y, z + dir.z, worldLightQuery);
+                            addFace(scratch, glm::vec3(x, y, z), face, m_blocks[voxelIndex(x, y, z)].type, light, opacity);
+                        }
+                    }
                 }
-                if (getNeighborBlockType(x, y - 1, z, worldBlockQuery) == BlockType::AIR) {
-                    addFace(vertices, indices, blockPos, 3, type, worldBlockQuery); // Bottom
-                }
-                if (getNeighborBlockType(x + 1, y, z, worldBlockQuery) == BlockType::AIR) {
-                    addFace(vertices, indices, blockPos, 4, type, worldBlockQuery); // Right
-                }
-                if (getNeighborBlockType(x - 1, y, z, worldBlockQuery) == BlockType::AIR) {
-                    addFace(vertices, indices, blockPos, 5, type, worldBlockQuery); // Left
+                
+                // Transparent blocks also hide faces against their own type, so the few
+                // there are take the per-voxel path
+                ColumnMask transparent = opacity.transparent[x][z];
+                while (transparent) {
+                    int y = countTrailingZeros(transparent);
+                    transparent &= transparent - 1;
+                    BlockType type = m_blocks[voxelIndex(x, y, z)].type;
+                    
+                    for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+                        glm::ivec3 n = glm::ivec3(x, y, z) + FACE_DIRECTIONS[face];
+                        if (isFaceVisible(type, getNeighborBlockType(n.x, n.y, n.z, worldBlockQuery))) {
+                            uint8_t light = getNeighborLight(n.x, n.y, n.z, worldLightQuery);
+                            addFace(scratch, glm::vec3(x, y, z), face, type, light, opacity);
+                        }
+                    }
                 }
             }
         }
     }
     
-    m_mesh.updateMesh(vertices, indices);
+    m_mesh.updateMesh(scratch);
     m_needsMeshUpdate = false;
+    Profiler::increment(ProfileCounter::CHUNKS_MESHED);
 }
 
 void Chunk::serialize(std::vector<uint8_t>& data) const {
@@ -296,40 +575,41 @@ void Chunk::serialize(std::vector<uint8_t>& data) const {
     data.insert(data.end(), reinterpret_cast<const uint8_t*>(pos), 
                 reinterpret_cast<const uint8_t*>(pos) + sizeof(pos));
     
-    // Write all blocks (CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE bytes)
-    for (int x = 0; x < CHUNK_SIZE; x++) {
-        for (int y = 0; y < CHUNK_HEIGHT; y++) {
-            for (int z = 0; z < CHUNK_SIZE; z++) {
-                uint8_t blockType = static_cast<uint8_t>(m_blocks[x][y][z].type);
-                data.push_back(blockType);
-            }
-        }
-    }
+    // Write all blocks (CHUNK_VOLUME bytes)
+    size_t blocksOffset = data.size();
+    data.resize(blocksOffset + CHUNK_VOLUME);
+    ChunkVoxelLayout::forEach([&](int x, int y, int z, int index) {
+        data[blocksOffset + getSavedBlockIndex(x, y, z)] = static_cast<uint8_t>(m_blocks[index].type);
+    });
 }
 
 bool Chunk::deserialize(const std::vector<uint8_t>& data) {
-    // Minimum size: 12 bytes (position) + CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE bytes (blocks)
-    size_t expectedSize = 12 + CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE;
+    // Minimum size: 12 bytes (position) + CHUNK_VOLUME bytes (blocks)
+    size_t expectedSize = 12 + CHUNK_VOLUME;
     if (data.size() < expectedSize) {
         return false;
     }
     
+    // A block type this build doesn't know (a corrupt file, or one saved by a newer
+    // version) would index past the block property table; reject the chunk untouched
+    // so the caller regenerates it instead
+    const uint8_t* blocks = data.data() + 12;
+    for (size_t i = 0; i < CHUNK_VOLUME; i++) {
+        if (blocks[i] >= BLOCK_TYPE_COUNT) {
+            return false;
+        }
+    }
+    
     // Read chunk position
     const int* pos = reinterpret_cast<const int*>(data.data());
     m_position = glm::ivec3(pos[0], pos[1], pos[2]);
     
     // Read all blocks
-    size_t offset = 12;
-    for (int x = 0; x < CHUNK_SIZE; x++) {
-        for (int y = 0; y < CHUNK_HEIGHT; y++) {
-            for (int z = 0; z < CHUNK_SIZE; z++) {
-                if (offset >= data.size()) {
-                    return false;
-                }
-                m_blocks[x][y][z].type = static_cast<BlockType>(data[offset++]);
-            }
-        }
-    }
+    ChunkVoxelLayout::forEach([&](int x, int y, int z, int index) {
+        m_blocks[index].type = static_cast<BlockType>(blocks[getSavedBlockIndex(x, y, z)]);
+    });
+    
+    rebuildOccupancy();
     
     // Mark as dirty so mesh gets regenerated
     m_needsMeshUpdate = true;
@@ -346,21 +626,16 @@ void Chunk::getBoundingBox(glm::vec3& min, glm::vec3& max) const {
     max.z = min.z + CHUNK_SIZE;
 }
 
-void Chunk::render(Shader& shader, unsigned int texture) const {
+void Chunk::render(const Shader& shader, Uniform<glm::vec3> offsetUniform) const {
     if (m_mesh.isEmpty()) {
         return;
     }
     
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(m_position.x * CHUNK_SIZE, 
-                                            m_position.y * CHUNK_HEIGHT, 
-                                            m_position.z * CHUNK_SIZE));
-    shader.setMat4("model", model);
-    
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture);
-    shader.setInt("texture1", 0);
+    shader.set(offsetUniform, glm::vec3(m_position.x * CHUNK_SIZE, 
+                                        m_position.y * CHUNK_HEIGHT, 
+                                        m_position.z * CHUNK_SIZE));
     
     m_mesh.draw();
+    Profiler::increment(ProfileCounter::CHUNKS_DRAWN);
+    Profiler::increment(ProfileCounter::TRIANGLES, m_mesh.getIndexCount() / 3);
 }
-